@@ -11,6 +11,11 @@
 #include "qserialport_p.h"
 
 #include <QtCore/qdebug.h>
+#include <QtCore/qmetaobject.h>
+#include <QtCore/qtimer.h>
+
+#include <climits>
+#include <cstring>
 
 QT_BEGIN_NAMESPACE
 
@@ -59,6 +64,19 @@ QSerialPortPrivate::QSerialPortPrivate()
     readBufferChunkSize = QSERIALPORT_BUFFERSIZE;
 }
 
+QTimer *QSerialPortPrivate::ensurePreciseTimer(QTimer *&timer, void (QSerialPortPrivate::*slot)())
+{
+    Q_Q(QSerialPort);
+
+    if (!timer) {
+        timer = new QTimer(q);
+        timer->setSingleShot(true);
+        timer->setTimerType(Qt::PreciseTimer);
+        QObjectPrivate::connect(timer, &QTimer::timeout, this, slot);
+    }
+    return timer;
+}
+
 void QSerialPortPrivate::setError(const QSerialPortErrorInfo &errorInfo)
 {
     Q_Q(QSerialPort);
@@ -69,6 +87,281 @@ void QSerialPortPrivate::setError(const QSerialPortErrorInfo &errorInfo)
     emit q->errorOccurred(error);
 }
 
+qint64 QSerialPortPrivate::effectiveWriteBurstSize() const
+{
+    // Without an explicit burst size, allow 10 ms worth of data at once
+    return writeBurstSize > 0 ? writeBurstSize : qMax(writeRateLimit / 100, qint64(1));
+}
+
+int QSerialPortPrivate::bitsPerCharacter() const
+{
+    // start bit, data bits, parity bit, stop bits
+    return 1 + dataBits.value()
+            + (parity.value() == QSerialPort::NoParity ? 0 : 1)
+            + (stopBits.value() == QSerialPort::OneStop ? 1 : 2);
+}
+
+std::chrono::milliseconds QSerialPortPrivate::transmitTimeEstimate() const
+{
+    using namespace std::chrono;
+
+    const qint64 queuedBytes = qMax(queuedBytesCount(QSerialPort::Output), qint64(1));
+    const qint64 bits = queuedBytes * bitsPerCharacter();
+    return milliseconds(qMax((bits * 1000 + outputBaudRate - 1) / outputBaudRate, qint64(1)));
+}
+
+bool QSerialPortPrivate::isAllBytesTransmittedConnected() const
+{
+    Q_Q(const QSerialPort);
+    static const QMetaMethod transmittedSignal = QMetaMethod::fromSignal(&QSerialPort::allBytesTransmitted);
+    return q->isSignalConnected(transmittedSignal);
+}
+
+void QSerialPortPrivate::startTransmitPolling()
+{
+    // Polling the driver is only worth it if somebody listens
+    if (!isAllBytesTransmittedConnected())
+        return;
+
+    ensurePreciseTimer(transmitPollTimer, &QSerialPortPrivate::pollTransmitted)
+            ->start(transmitTimeEstimate());
+}
+
+void QSerialPortPrivate::pollTransmitted()
+{
+    Q_Q(QSerialPort);
+
+    // More data was written meanwhile, its completion restarts the polling
+    if (q->bytesToWrite() > 0 || !isAllBytesTransmittedConnected())
+        return;
+
+    if (!isTransmitComplete()) {
+        transmitPollTimer->start(transmitTimeEstimate());
+        return;
+    }
+
+    emit q->allBytesTransmitted();
+}
+
+bool QSerialPortPrivate::waitForTransmitted(QDeadlineTimer deadline)
+{
+    Q_Q(QSerialPort);
+
+    while (!isTransmitComplete()) {
+        if (deadline.hasExpired()) {
+            setError(QSerialPortErrorInfo(QSerialPort::TimeoutError));
+            return false;
+        }
+        const QDeadlineTimer pollDeadline(transmitTimeEstimate());
+        if (!sleepInterruptibly(qMin(pollDeadline, deadline)))
+            return false;
+    }
+
+    if (transmitPollTimer && transmitPollTimer->isActive()) {
+        transmitPollTimer->stop();
+        emit q->allBytesTransmitted();
+    }
+    return true;
+}
+
+std::chrono::microseconds QSerialPortPrivate::effectiveInterFrameTimeout() const
+{
+    using namespace std::chrono;
+
+    if (interFrameTimeout.count() > 0)
+        return interFrameTimeout;
+
+    // Above 19200 baud, 3.5 character times are too short to be measured
+    // reliably, so use the fixed gap the Modbus RTU specification recommends.
+    if (inputBaudRate > QSerialPort::Baud19200)
+        return microseconds(1750);
+
+    return microseconds((qint64(bitsPerCharacter()) * 3500000 + inputBaudRate - 1) / inputBaudRate);
+}
+
+void QSerialPortPrivate::checkInterFrameGap()
+{
+    using namespace std::chrono;
+
+    // The data read last is a frame of its own if the line was idle for
+    // longer than the inter-frame timeout, even if the timer did not fire yet.
+    if (!frameBuffer.isEmpty() && frameElapsedTimer.isValid()
+            && nanoseconds(frameElapsedTimer.nsecsElapsed()) >= effectiveInterFrameTimeout()) {
+        completeFrame();
+    }
+}
+
+void QSerialPortPrivate::restartInterFrameTimer()
+{
+    frameElapsedTimer.start();
+
+    ensurePreciseTimer(interFrameTimer, &QSerialPortPrivate::interFrameTimerExpired)
+            ->start(std::chrono::ceil<std::chrono::milliseconds>(effectiveInterFrameTimeout()));
+}
+
+void QSerialPortPrivate::interFrameTimerExpired()
+{
+    using namespace std::chrono;
+
+    const nanoseconds idle(frameElapsedTimer.nsecsElapsed());
+    const nanoseconds timeout = effectiveInterFrameTimeout();
+    if (idle < timeout) {
+        interFrameTimer->start(ceil<milliseconds>(timeout - idle));
+        return;
+    }
+
+    completeFrame();
+}
+
+int QSerialPortPrivate::remainingInterFrameGap() const
+{
+    using namespace std::chrono;
+
+    // Returns -1 if there is no pending frame to complete
+    if (frameBuffer.isEmpty() || !frameElapsedTimer.isValid())
+        return -1;
+
+    const nanoseconds idle(frameElapsedTimer.nsecsElapsed());
+    const nanoseconds timeout = effectiveInterFrameTimeout();
+    return idle < timeout ? int(ceil<milliseconds>(timeout - idle).count()) : 0;
+}
+
+void QSerialPortPrivate::completeFrame()
+{
+    Q_Q(QSerialPort);
+
+    if (interFrameTimer)
+        interFrameTimer->stop();
+
+    if (frameBuffer.isEmpty())
+        return;
+
+    const QByteArray frame = std::exchange(frameBuffer, QByteArray());
+    frameCompleted = true;
+    emit q->frameReceived(frame);
+}
+
+void QSerialPortPrivate::recordReceivedData(qint64 bytes)
+{
+    if (receiveTimestampsEnabled) {
+        dropConsumedTimestamps();
+        receiveTimestamps.append({std::chrono::steady_clock::now(), totalBytesReceived, bytes});
+    }
+    totalBytesReceived += bytes;
+}
+
+void QSerialPortPrivate::dropConsumedTimestamps()
+{
+    const qint64 consumedBytes = totalBytesReceived - buffer.size();
+    while (!receiveTimestamps.isEmpty()) {
+        const ReceiveTimestamp &first = receiveTimestamps.constFirst();
+        if (first.position + first.size > consumedBytes)
+            break;
+        receiveTimestamps.removeFirst();
+    }
+}
+
+qint64 QSerialPortPrivate::findLineEnd() const
+{
+    const qint64 pos = findDelimiter(lineDelimiter, &lineScanPosition);
+    return pos < 0 ? qint64(-1) : pos + lineDelimiter.size();
+}
+
+qint64 QSerialPortPrivate::findDelimiter(QByteArrayView delimiter, qint64 *scanPosition) const
+{
+    // Positions are relative to the buffer start, scanPosition is kept
+    // within all data received, so that it survives reads.
+    const qint64 bufferPosition = totalBytesReceived - buffer.size();
+    const qint64 startPos = transactionStarted ? transactionPos : 0;
+    const qint64 delimiterSize = delimiter.size();
+    const char delimiterFirst = delimiter.at(0);
+
+    qint64 pos = qMax(startPos, *scanPosition - bufferPosition);
+    while (pos < buffer.size()) {
+        qint64 length = 0;
+        const char *block = buffer.readPointerAtPosition(pos, length);
+        const auto found = static_cast<const char *>(std::memchr(block, delimiterFirst, length));
+        if (!found) {
+            pos += length;
+            continue;
+        }
+
+        pos += found - block;
+        if (pos + delimiterSize > buffer.size())
+            break;
+        if (isDelimiterAt(pos, delimiter)) {
+            *scanPosition = bufferPosition + pos;
+            return pos;
+        }
+        ++pos;
+    }
+
+    // A multi-byte delimiter might be split by the next incoming chunk.
+    *scanPosition = bufferPosition + qMax(startPos, qMin(pos, buffer.size() - delimiterSize + 1));
+    return -1;
+}
+
+bool QSerialPortPrivate::isDelimiterAt(qint64 pos, QByteArrayView delimiter) const
+{
+    const qint64 delimiterSize = delimiter.size();
+    for (qint64 matched = 0; matched < delimiterSize;) {
+        qint64 length = 0;
+        const char *block = buffer.readPointerAtPosition(pos + matched, length);
+        length = qMin(length, delimiterSize - matched);
+        if (std::memcmp(block, delimiter.data() + matched, length) != 0)
+            return false;
+        matched += length;
+    }
+    return true;
+}
+
+bool QSerialPortPrivate::waitForBytesAvailable(qint64 count, QDeadlineTimer deadline)
+{
+    Q_Q(QSerialPort);
+
+    // Keep receiving without returning to the caller for every chunk.
+    while (q->bytesAvailable() < count) {
+        if (!waitForReadyRead(int(qMin(deadline.remainingTime(), qint64(INT_MAX)))))
+            return false;
+    }
+    return true;
+}
+
+bool QSerialPortPrivate::waitForDelimiter(QByteArrayView delimiter, QDeadlineTimer deadline)
+{
+    // Only the data received since the previous wakeup is scanned again.
+    qint64 scanPosition = totalBytesReceived - buffer.size();
+    while (findDelimiter(delimiter, &scanPosition) < 0) {
+        if (!waitForReadyRead(int(qMin(deadline.remainingTime(), qint64(INT_MAX)))))
+            return false;
+    }
+    return true;
+}
+
+void QSerialPortPrivate::updateReadThrottling()
+{
+    const qint64 bufferedBytes = buffer.size();
+    if (!readThrottled && readHighWatermark > 0 && bufferedBytes >= readHighWatermark)
+        setReadThrottled(true);
+    else if (readThrottled && (readHighWatermark == 0 || bufferedBytes <= readLowWatermark))
+        setReadThrottled(false);
+}
+
+void QSerialPortPrivate::setReadThrottled(bool throttled)
+{
+    Q_Q(QSerialPort);
+
+#if defined(Q_OS_UNIX)
+    // Report a failure to throttle the sender once, and keep signaling
+    // the backpressure to the application anyway.
+    if (!senderThrottlingFailed && !setSenderThrottled(throttled))
+        senderThrottlingFailed = true;
+#endif
+
+    readThrottled = throttled;
+    emit q->readThrottledChanged(throttled);
+}
+
 /*!
     \class QSerialPort
 
@@ -288,6 +581,41 @@ void QSerialPortPrivate::setError(const QSerialPortErrorInfo &errorInfo)
     QSerialPort::requestToSend
 */
 
+/*!
+    \enum QSerialPort::ReadChunkPolicy
+    \since 6.8
+
+    This enum describes how much space is reserved in the internal read
+    buffer for each read from the serial port.
+
+    \value FixedReadChunk       A fixed-size block is reserved for every read,
+                                and the unused part of it is released
+                                afterwards. This is the default.
+    \value AdaptiveReadChunk    Only the amount of data queued in the driver
+                                is reserved, as reported by the operating
+                                system. This avoids reallocations in the read
+                                buffer when mostly small chunks of data are
+                                received.
+
+    \sa setReadChunkPolicy()
+*/
+
+/*!
+    \enum QSerialPort::WritePriority
+    \since 6.8
+
+    This enum describes the priority of data written to the serial port.
+
+    \value NormalPriority       The data is written after all data written
+                                before it. This is the priority of the data
+                                written with QIODevice::write().
+    \value UrgentPriority       The data is written ahead of the data of
+                                normal priority which is still waiting to be
+                                written.
+
+    \sa write()
+*/
+
 /*!
     \enum QSerialPort::SerialPortError
 
@@ -440,6 +768,12 @@ QString QSerialPort::portName() const
     \warning The \a mode has to be QIODeviceBase::ReadOnly, QIODeviceBase::WriteOnly,
     or QIODeviceBase::ReadWrite. Other modes are unsupported.
 
+    Since Qt 6.8, the mode can additionally contain QIODeviceBase::Unbuffered
+    on Unix platforms. In that case, read() copies the data directly from the
+    driver into the caller's buffer, and write() passes the data directly to
+    the driver while no data is queued for writing. The readyRead() signal is
+    emitted once for each arrival of data and is re-enabled by the next read.
+
     \sa QIODeviceBase::OpenMode, setPort()
 */
 bool QSerialPort::open(OpenMode mode)
@@ -452,8 +786,12 @@ bool QSerialPort::open(OpenMode mode)
     }
 
     // Define while not supported modes.
+#if defined(Q_OS_UNIX)
+    static const OpenMode unsupportedModes = Append | Truncate | Text;
+#else
     static const OpenMode unsupportedModes = Append | Truncate | Text | Unbuffered;
-    if ((mode & unsupportedModes) || mode == NotOpen) {
+#endif
+    if ((mode & unsupportedModes) || !(mode & ReadWrite)) {
         d->setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError, tr("Unsupported open mode")));
         return false;
     }
@@ -482,8 +820,23 @@ void QSerialPort::close()
         return;
     }
 
+    // The partial frame was received completely, as nothing can follow it
+    d->completeFrame();
+
     d->close();
     d->isBreakEnabled.setValue(false);
+    if (d->transmitPollTimer)
+        d->transmitPollTimer->stop();
+    d->receiveTimestamps.clear();
+    d->urgentWriteBuffer.clear();
+    d->writeFrameSizes.clear();
+    d->writeTokenTimer.invalidate();
+    d->nextWriteFrameDeadline = QDeadlineTimer();
+    d->senderThrottlingFailed = false;
+    if (d->readThrottled) {
+        d->readThrottled = false;
+        emit readThrottledChanged(false);
+    }
     QIODevice::close();
 }
 
@@ -617,6 +970,14 @@ QBindable<QSerialPort::DataBits> QSerialPort::bindableDataBits()
     setting is done automatically in the \l{QSerialPort::open()} method right
     after that the opening of the port succeeds.
 
+    \note On Unix platforms without native support for MarkParity and
+    SpaceParity, these modes are emulated by switching between even and odd
+    parity. Each switch waits until the data written before has been
+    transmitted, which blocks the thread owning the serial port for that
+    time. At most one switch is done per write to the driver, so that the
+    event loop runs between them, but the wait can still be noticeable at
+    low baud rates.
+
     The default value is NoParity, i.e. no parity.
 */
 bool QSerialPort::setParity(Parity parity)
@@ -756,127 +1117,364 @@ QBindable<QSerialPort::FlowControl> QSerialPort::bindableFlowControl()
 */
 
 /*!
-    \property QSerialPort::dataTerminalReady
-    \brief the state (high or low) of the line signal DTR
+    \class QSerialPort::Rs485Settings
+    \inmodule QtSerialPort
+    \since 6.8
 
-    Returns \c true on success, \c false otherwise.
-    If the flag is \c true then the DTR signal is set to high; otherwise low.
+    \brief Holds the RS-485 settings of the serial port driver.
 
-    \note The serial port has to be open before trying to set or get this
-    property; otherwise \c false is returned and the error code is set to
-    NotOpenError.
+    \ingroup shared
 
-    \sa pinoutSignals()
+    With RS-485 enabled, the driver switches the bus direction by itself,
+    using the RTS line, right before and after the transmission of data.
+
+    \sa QSerialPort::setRs485Settings()
 */
-bool QSerialPort::setDataTerminalReady(bool set)
-{
-    Q_D(QSerialPort);
 
-    if (!isOpen()) {
-        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
-        qWarning("%s: device not open", Q_FUNC_INFO);
-        return false;
-    }
+/*!
+    Constructs the default settings, with the RS-485 mode disabled.
+*/
+QSerialPort::Rs485Settings::Rs485Settings()
+    : d(new QSerialPortRs485SettingsPrivate)
+{
+}
 
-    const bool dataTerminalReady = isDataTerminalReady();
-    const bool retval = d->setDataTerminalReady(set);
-    if (retval && (dataTerminalReady != set))
-        emit dataTerminalReadyChanged(set);
+/*!
+    Constructs a copy of \a other.
+*/
+QSerialPort::Rs485Settings::Rs485Settings(const Rs485Settings &other) = default;
 
-    return retval;
-}
+/*!
+    \fn QSerialPort::Rs485Settings::Rs485Settings(Rs485Settings &&other)
 
-bool QSerialPort::isDataTerminalReady()
-{
-    Q_D(QSerialPort);
-    return d->pinoutSignals() & QSerialPort::DataTerminalReadySignal;
-}
+    Move-constructs the settings from \a other.
+*/
 
 /*!
-    \fn void QSerialPort::dataTerminalReadyChanged(bool set)
+    Assigns \a other to these settings and returns a reference to them.
+*/
+QSerialPort::Rs485Settings &QSerialPort::Rs485Settings::operator=(const Rs485Settings &other) = default;
 
-    This signal is emitted after the state (high or low) of the line signal DTR
-    has been changed. The new the state (high or low) of the line signal DTR is
-    passed as \a set.
+/*!
+    \fn QSerialPort::Rs485Settings &QSerialPort::Rs485Settings::operator=(Rs485Settings &&other)
 
-    \sa QSerialPort::dataTerminalReady
+    Move-assigns \a other to these settings.
 */
 
 /*!
-    \property QSerialPort::requestToSend
-    \brief the state (high or low) of the line signal RTS
+    Destroys the settings.
+*/
+QSerialPort::Rs485Settings::~Rs485Settings() = default;
 
-    Returns \c true on success, \c false otherwise.
-    If the flag is \c true then the RTS signal is set to high; otherwise low.
+/*!
+    \fn void QSerialPort::Rs485Settings::swap(Rs485Settings &other)
 
-    \note The serial port has to be open before trying to set or get this
-    property; otherwise \c false is returned and the error code is set to
-    NotOpenError.
+    Swaps these settings with \a other.
+*/
 
-    \note An attempt to control the RTS signal in the HardwareControl mode
-    will fail with error code set to UnsupportedOperationError, because
-    the signal is automatically controlled by the driver.
+/*!
+    Returns \c true if the RS-485 mode of the driver is enabled. The
+    default is \c false.
 
-    \sa pinoutSignals()
+    \sa setEnabled()
 */
-bool QSerialPort::setRequestToSend(bool set)
+bool QSerialPort::Rs485Settings::isEnabled() const
 {
-    Q_D(QSerialPort);
+    return d->enabled;
+}
 
-    if (!isOpen()) {
-        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
-        qWarning("%s: device not open", Q_FUNC_INFO);
-        return false;
-    }
+/*!
+    Enables the RS-485 mode of the driver if \a enabled is \c true.
 
-    if (d->flowControl == QSerialPort::HardwareControl) {
-        d->setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError));
-        return false;
-    }
+    \sa isEnabled()
+*/
+void QSerialPort::Rs485Settings::setEnabled(bool enabled)
+{
+    d->enabled = enabled;
+}
 
-    const bool requestToSend = isRequestToSend();
-    const bool retval = d->setRequestToSend(set);
-    if (retval && (requestToSend != set))
-        emit requestToSendChanged(set);
+/*!
+    Returns \c true if the RTS line is set while sending. The default is
+    \c true.
 
-    return retval;
+    \sa setRtsOnSend()
+*/
+bool QSerialPort::Rs485Settings::rtsOnSend() const
+{
+    return d->rtsOnSend;
 }
 
-bool QSerialPort::isRequestToSend()
+/*!
+    Sets the RTS line while sending if \a set is \c true.
+
+    \sa rtsOnSend()
+*/
+void QSerialPort::Rs485Settings::setRtsOnSend(bool set)
 {
-    Q_D(QSerialPort);
-    return d->pinoutSignals() & QSerialPort::RequestToSendSignal;
+    d->rtsOnSend = set;
 }
 
 /*!
-    \fn void QSerialPort::requestToSendChanged(bool set)
+    Returns \c true if the RTS line is set after sending. The default is
+    \c false.
 
-    This signal is emitted after the state (high or low) of the line signal RTS
-    has been changed. The new the state (high or low) of the line signal RTS is
-    passed as \a set.
-
-    \sa QSerialPort::requestToSend
+    \sa setRtsAfterSend()
 */
+bool QSerialPort::Rs485Settings::rtsAfterSend() const
+{
+    return d->rtsAfterSend;
+}
 
 /*!
-    Returns the state of the line signals in a bitmap format.
+    Sets the RTS line after sending if \a set is \c true.
 
-    From this result, it is possible to allocate the state of the
-    desired signal by applying a mask "AND", where the mask is
-    the desired enumeration value from QSerialPort::PinoutSignals.
-
-    \note This method performs a system call, thus ensuring that the line signal
-    states are returned properly. This is necessary when the underlying
-    operating systems cannot provide proper notifications about the changes.
+    \sa rtsAfterSend()
+*/
+void QSerialPort::Rs485Settings::setRtsAfterSend(bool set)
+{
+    d->rtsAfterSend = set;
+}
 
-    \note The serial port has to be open before trying to get the pinout
-    signals; otherwise returns NoSignal and sets the NotOpenError error code.
+/*!
+    Returns \c true if data is received while sending. The default is
+    \c false.
 
-    \sa QSerialPort::dataTerminalReady, QSerialPort::requestToSend
+    \sa setReceiveDuringTransmit()
 */
-QSerialPort::PinoutSignals QSerialPort::pinoutSignals()
+bool QSerialPort::Rs485Settings::receiveDuringTransmit() const
 {
-    Q_D(QSerialPort);
+    return d->receiveDuringTransmit;
+}
+
+/*!
+    Receives data while sending if \a receive is \c true.
+
+    \sa receiveDuringTransmit()
+*/
+void QSerialPort::Rs485Settings::setReceiveDuringTransmit(bool receive)
+{
+    d->receiveDuringTransmit = receive;
+}
+
+/*!
+    Returns the delay between setting RTS and the start of the
+    transmission. The default is zero.
+
+    \sa setDelayBeforeSend()
+*/
+std::chrono::milliseconds QSerialPort::Rs485Settings::delayBeforeSend() const
+{
+    return d->delayBeforeSend;
+}
+
+/*!
+    Sets the delay between setting RTS and the start of the transmission
+    to \a delay.
+
+    \sa delayBeforeSend()
+*/
+void QSerialPort::Rs485Settings::setDelayBeforeSend(std::chrono::milliseconds delay)
+{
+    d->delayBeforeSend = delay;
+}
+
+/*!
+    Returns the delay between the end of the transmission and resetting
+    RTS. The default is zero.
+
+    \sa setDelayAfterSend()
+*/
+std::chrono::milliseconds QSerialPort::Rs485Settings::delayAfterSend() const
+{
+    return d->delayAfterSend;
+}
+
+/*!
+    Sets the delay between the end of the transmission and resetting RTS
+    to \a delay.
+
+    \sa delayAfterSend()
+*/
+void QSerialPort::Rs485Settings::setDelayAfterSend(std::chrono::milliseconds delay)
+{
+    d->delayAfterSend = delay;
+}
+
+/*!
+    \since 6.8
+
+    Configures the RS-485 mode of the serial port driver with \a settings.
+
+    If the setting is successful or set before opening the port, returns
+    \c true; otherwise returns \c false and sets an error code which can be
+    obtained by accessing the value of the QSerialPort::error property.
+    If the setting is set before opening the port, it is applied in open(),
+    which fails if the driver does not support the RS-485 mode. Disabled
+    settings are not applied in open(), so that they do not make open()
+    fail on ports without RS-485 support, even if the RS-485 mode was
+    enabled before.
+
+    Once applied, rs485Settings() returns the settings as accepted by the
+    driver, which may have limited the delays to the values supported by
+    the hardware.
+
+    \note This setting is only supported on Linux. On other platforms,
+    open() and this method fail with the UnsupportedOperationError error
+    code.
+
+    \sa rs485Settings()
+*/
+bool QSerialPort::setRs485Settings(const Rs485Settings &settings)
+{
+    Q_D(QSerialPort);
+
+    if (isOpen()) {
+        if (!d->setRs485Settings(settings))
+            return false;
+    } else {
+        d->rs485Settings = settings;
+    }
+
+    d->rs485SettingsSet = settings.isEnabled();
+    return true;
+}
+
+/*!
+    \since 6.8
+
+    Returns the RS-485 settings of the serial port. After the settings have
+    been applied, these are the settings as accepted by the driver.
+
+    \sa setRs485Settings()
+*/
+QSerialPort::Rs485Settings QSerialPort::rs485Settings() const
+{
+    Q_D(const QSerialPort);
+    return d->rs485Settings;
+}
+
+/*!
+    \property QSerialPort::dataTerminalReady
+    \brief the state (high or low) of the line signal DTR
+
+    Returns \c true on success, \c false otherwise.
+    If the flag is \c true then the DTR signal is set to high; otherwise low.
+
+    \note The serial port has to be open before trying to set or get this
+    property; otherwise \c false is returned and the error code is set to
+    NotOpenError.
+
+    \sa pinoutSignals()
+*/
+bool QSerialPort::setDataTerminalReady(bool set)
+{
+    Q_D(QSerialPort);
+
+    if (!isOpen()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        qWarning("%s: device not open", Q_FUNC_INFO);
+        return false;
+    }
+
+    const bool dataTerminalReady = isDataTerminalReady();
+    const bool retval = d->setDataTerminalReady(set);
+    if (retval && (dataTerminalReady != set))
+        emit dataTerminalReadyChanged(set);
+
+    return retval;
+}
+
+bool QSerialPort::isDataTerminalReady()
+{
+    Q_D(QSerialPort);
+    return d->pinoutSignals() & QSerialPort::DataTerminalReadySignal;
+}
+
+/*!
+    \fn void QSerialPort::dataTerminalReadyChanged(bool set)
+
+    This signal is emitted after the state (high or low) of the line signal DTR
+    has been changed. The new the state (high or low) of the line signal DTR is
+    passed as \a set.
+
+    \sa QSerialPort::dataTerminalReady
+*/
+
+/*!
+    \property QSerialPort::requestToSend
+    \brief the state (high or low) of the line signal RTS
+
+    Returns \c true on success, \c false otherwise.
+    If the flag is \c true then the RTS signal is set to high; otherwise low.
+
+    \note The serial port has to be open before trying to set or get this
+    property; otherwise \c false is returned and the error code is set to
+    NotOpenError.
+
+    \note An attempt to control the RTS signal in the HardwareControl mode
+    will fail with error code set to UnsupportedOperationError, because
+    the signal is automatically controlled by the driver.
+
+    \sa pinoutSignals()
+*/
+bool QSerialPort::setRequestToSend(bool set)
+{
+    Q_D(QSerialPort);
+
+    if (!isOpen()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        qWarning("%s: device not open", Q_FUNC_INFO);
+        return false;
+    }
+
+    if (d->flowControl == QSerialPort::HardwareControl) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError));
+        return false;
+    }
+
+    const bool requestToSend = isRequestToSend();
+    const bool retval = d->setRequestToSend(set);
+    if (retval && (requestToSend != set))
+        emit requestToSendChanged(set);
+
+    return retval;
+}
+
+bool QSerialPort::isRequestToSend()
+{
+    Q_D(QSerialPort);
+    return d->pinoutSignals() & QSerialPort::RequestToSendSignal;
+}
+
+/*!
+    \fn void QSerialPort::requestToSendChanged(bool set)
+
+    This signal is emitted after the state (high or low) of the line signal RTS
+    has been changed. The new the state (high or low) of the line signal RTS is
+    passed as \a set.
+
+    \sa QSerialPort::requestToSend
+*/
+
+/*!
+    Returns the state of the line signals in a bitmap format.
+
+    From this result, it is possible to allocate the state of the
+    desired signal by applying a mask "AND", where the mask is
+    the desired enumeration value from QSerialPort::PinoutSignals.
+
+    \note This method performs a system call, thus ensuring that the line signal
+    states are returned properly. This is necessary when the underlying
+    operating systems cannot provide proper notifications about the changes.
+
+    \note The serial port has to be open before trying to get the pinout
+    signals; otherwise returns NoSignal and sets the NotOpenError error code.
+
+    \sa QSerialPort::dataTerminalReady, QSerialPort::requestToSend
+*/
+QSerialPort::PinoutSignals QSerialPort::pinoutSignals()
+{
+    Q_D(QSerialPort);
 
     if (!isOpen()) {
         d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
@@ -930,95 +1528,1072 @@ bool QSerialPort::clear(Directions directions)
 {
     Q_D(QSerialPort);
 
-    if (!isOpen()) {
-        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
-        qWarning("%s: device not open", Q_FUNC_INFO);
-        return false;
-    }
+    if (!isOpen()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        qWarning("%s: device not open", Q_FUNC_INFO);
+        return false;
+    }
+
+    if (directions & Input)
+        d->buffer.clear();
+    if (directions & Output) {
+        d->writeBuffer.clear();
+        d->urgentWriteBuffer.clear();
+        d->writeFrameSizes.clear();
+    }
+    const bool result = d->clear(directions);
+    // The sender is resumed once the cleared buffer has room again
+    if (directions & Input)
+        d->updateReadThrottling();
+    return result;
+}
+
+/*!
+    \property QSerialPort::error
+    \brief the error status of the serial port
+
+    The I/O device status returns an error code. For example, if open()
+    returns \c false, or a read/write operation returns \c -1, this property can
+    be used to figure out the reason why the operation failed.
+
+    The error code is set to the default QSerialPort::NoError after a call to
+    clearError()
+*/
+QSerialPort::SerialPortError QSerialPort::error() const
+{
+    Q_D(const QSerialPort);
+    return d->error;
+}
+
+void QSerialPort::clearError()
+{
+    Q_D(QSerialPort);
+    d->setError(QSerialPortErrorInfo(QSerialPort::NoError));
+}
+
+QBindable<QSerialPort::SerialPortError> QSerialPort::bindableError() const
+{
+    return &d_func()->error;
+}
+
+/*!
+    \fn void QSerialPort::errorOccurred(SerialPortError error)
+    \since 5.8
+
+    This signal is emitted when an error occurs in the serial port.
+    The specified \a error describes the type of error that occurred.
+
+    \sa QSerialPort::error
+*/
+
+/*!
+    Returns the size of the internal read buffer. This limits the
+    amount of data that the client can receive before calling the read()
+    or readAll() methods.
+
+    A read buffer size of \c 0 (the default) means that the buffer has
+    no size limit, ensuring that no data is lost.
+
+    \sa setReadBufferSize(), read()
+*/
+qint64 QSerialPort::readBufferSize() const
+{
+    Q_D(const QSerialPort);
+    return d->readBufferMaxSize;
+}
+
+/*!
+    Sets the size of QSerialPort's internal read buffer to be \a
+    size bytes.
+
+    If the buffer size is limited to a certain size, QSerialPort
+    will not buffer more than this size of data. The special case of a buffer
+    size of \c 0 means that the read buffer is unlimited and all
+    incoming data is buffered. This is the default.
+
+    This option is useful if the data is only read at certain points
+    in time (for instance in a real-time streaming application) or if the serial
+    port should be protected against receiving too much data, which may
+    eventually cause the application to run out of memory.
+
+    \sa readBufferSize(), read()
+*/
+void QSerialPort::setReadBufferSize(qint64 size)
+{
+    Q_D(QSerialPort);
+    d->readBufferMaxSize = size;
+    if (isReadable())
+        d->startAsyncRead();
+}
+
+/*!
+    \since 6.8
+
+    Sets the low and high watermarks of the internal read buffer to
+    \a lowMark and \a highMark bytes.
+
+    When the amount of buffered data reaches \a highMark, QSerialPort
+    throttles the sender according to the flowControl() setting: with
+    HardwareControl it stops reading from the driver, which controls the
+    RTS line in this mode and clears it once its own queue fills up; with
+    SoftwareControl an XOFF character is sent. Once the application has
+    read enough data for the buffered amount to drop to \a lowMark or
+    below, the sender is resumed by reading from the driver again or by
+    sending an XON character. The readThrottledChanged() signal is emitted
+    in both cases, also when flowControl() is NoFlowControl, so that the
+    application can apply backpressure further on its own.
+
+    The buffered amount is checked again after the
+    \l{QIODevice::}{readyRead()} signal has been emitted, when the
+    application has read all of the buffered data, when the input buffer is
+    cleared, and before a blocking wait for new data. A read that leaves
+    data in the buffer does not resume the sender by itself. While the
+    sender is throttled with HardwareControl, the blocking waits do not
+    wait for new data. If throttling the sender
+    fails, the error is reported once and the sender is not throttled
+    anymore until the port is reopened, while readThrottledChanged() is
+    still emitted.
+
+    A \a highMark of \c 0 (the default) disables the watermarks.
+
+    \note Throttling the sender only has an effect on Unix platforms.
+    On other platforms only the signal is emitted.
+
+    \sa readBufferLowWatermark(), readBufferHighWatermark(),
+    isReadThrottled(), setReadBufferSize()
+*/
+void QSerialPort::setReadBufferWatermarks(qint64 lowMark, qint64 highMark)
+{
+    Q_D(QSerialPort);
+    d->readHighWatermark = qMax(highMark, qint64(0));
+    d->readLowWatermark = qBound(qint64(0), lowMark, d->readHighWatermark);
+    if (isOpen())
+        d->updateReadThrottling();
+}
+
+/*!
+    \since 6.8
+
+    Returns the low watermark of the internal read buffer.
+
+    \sa setReadBufferWatermarks()
+*/
+qint64 QSerialPort::readBufferLowWatermark() const
+{
+    Q_D(const QSerialPort);
+    return d->readLowWatermark;
+}
+
+/*!
+    \since 6.8
+
+    Returns the high watermark of the internal read buffer.
+
+    \sa setReadBufferWatermarks()
+*/
+qint64 QSerialPort::readBufferHighWatermark() const
+{
+    Q_D(const QSerialPort);
+    return d->readHighWatermark;
+}
+
+/*!
+    \since 6.8
+
+    Returns \c true if the sender is throttled because the internal read
+    buffer reached its high watermark; otherwise returns \c false.
+
+    \sa setReadBufferWatermarks(), readThrottledChanged()
+*/
+bool QSerialPort::isReadThrottled() const
+{
+    Q_D(const QSerialPort);
+    return d->readThrottled;
+}
+
+/*!
+    \since 6.8
+
+    Returns the policy used to reserve space in the internal read buffer.
+
+    \sa setReadChunkPolicy()
+*/
+QSerialPort::ReadChunkPolicy QSerialPort::readChunkPolicy() const
+{
+    Q_D(const QSerialPort);
+    return d->readChunkPolicy;
+}
+
+/*!
+    \since 6.8
+
+    Sets the \a policy used to reserve space in the internal read buffer
+    for each read from the serial port.
+
+    The default is FixedReadChunk. Consider AdaptiveReadChunk when many
+    serial ports receive mostly small chunks of data.
+
+    \note This setting only has an effect on Unix platforms.
+
+    \sa readChunkPolicy(), setReadBufferSize()
+*/
+void QSerialPort::setReadChunkPolicy(ReadChunkPolicy policy)
+{
+    Q_D(QSerialPort);
+    d->readChunkPolicy = policy;
+}
+
+/*!
+    \since 6.8
+
+    Sets the limits for draining the driver on each read notification to
+    \a maxBytes bytes and \a maxDuration.
+
+    By default, QSerialPort reads from the port once per notification of
+    incoming data and emits readyRead() for each read. When any of the limits
+    is non-zero, QSerialPort keeps reading until the driver has no more data
+    queued or until one of the limits is reached, and then emits readyRead()
+    once. A limit of zero means that the corresponding dimension is not
+    limited. Setting both limits to zero restores the default behavior.
+
+    This reduces the event loop overhead and the number of readyRead()
+    emissions when the serial port receives data at high baud rates.
+
+    \note This setting only has an effect on Unix platforms.
+
+    \sa readDrainMaxBytes(), readDrainMaxDuration()
+*/
+void QSerialPort::setReadDrainLimits(qint64 maxBytes, std::chrono::microseconds maxDuration)
+{
+    Q_D(QSerialPort);
+    d->readDrainMaxBytes = qMax(maxBytes, qint64(0));
+    d->readDrainMaxDuration = qMax(maxDuration, std::chrono::microseconds::zero());
+}
+
+/*!
+    \since 6.8
+
+    Returns the maximum number of bytes read on one read notification,
+    or \c 0 if the amount is not limited.
+
+    \sa setReadDrainLimits()
+*/
+qint64 QSerialPort::readDrainMaxBytes() const
+{
+    Q_D(const QSerialPort);
+    return d->readDrainMaxBytes;
+}
+
+/*!
+    \since 6.8
+
+    Returns the maximum time spent reading on one read notification,
+    or zero if the time is not limited.
+
+    \sa setReadDrainLimits()
+*/
+std::chrono::microseconds QSerialPort::readDrainMaxDuration() const
+{
+    Q_D(const QSerialPort);
+    return d->readDrainMaxDuration;
+}
+
+/*!
+    \since 6.8
+
+    Holds back the \l{QIODevice::}{readyRead()} signal until at least
+    \a bytes bytes are available for reading, or until \a maxDelay has
+    passed since the first data that was held back arrived.
+
+    This allows consumers that parse data on each readyRead() emission to
+    process it in batches, while \a maxDelay still bounds the latency. If
+    \a maxDelay is zero, the signal is held back until the threshold is
+    reached. A threshold of \c 0 (the default) emits readyRead() for every
+    chunk of data received.
+
+    If the read buffer size is limited, the threshold never exceeds it.
+    waitForReadyRead() does not wait for the threshold to be reached.
+
+    \note This setting only has an effect on Unix platforms.
+
+    \sa readyReadThreshold(), readyReadMaxDelay(), setReadBufferSize()
+*/
+void QSerialPort::setReadyReadThreshold(qint64 bytes, std::chrono::milliseconds maxDelay)
+{
+    Q_D(QSerialPort);
+    d->readyReadThreshold = qMax(bytes, qint64(0));
+    d->readyReadMaxDelay = qMax(maxDelay, std::chrono::milliseconds::zero());
+}
+
+/*!
+    \since 6.8
+
+    Returns the number of bytes that have to be available before
+    \l{QIODevice::}{readyRead()} is emitted.
+
+    \sa setReadyReadThreshold()
+*/
+qint64 QSerialPort::readyReadThreshold() const
+{
+    Q_D(const QSerialPort);
+    return d->readyReadThreshold;
+}
+
+/*!
+    \since 6.8
+
+    Returns the maximum time \l{QIODevice::}{readyRead()} is held back
+    while waiting for the threshold to be reached.
+
+    \sa setReadyReadThreshold()
+*/
+std::chrono::milliseconds QSerialPort::readyReadMaxDelay() const
+{
+    Q_D(const QSerialPort);
+    return d->readyReadMaxDelay;
+}
+
+/*!
+    \since 6.8
+
+    If \a enable is \c true, enables the frame delimiting mode; otherwise
+    disables it.
+
+    In the frame delimiting mode, the received data is split into frames
+    at periods of silence on the line, as done by Modbus RTU and many other
+    fieldbus protocols. Each frame is delivered with the frameReceived()
+    signal once the line has been idle for interFrameTimeout(). The received
+    data is not added to the internal read buffer, and
+    \l{QIODevice::}{readyRead()} is not emitted for it.
+
+    If the read buffer size is limited, a frame is delivered as soon as it
+    reaches that size.
+
+    When the mode is disabled or the serial port is closed, a pending partial
+    frame is delivered immediately.
+
+    In this mode, waitForReadyRead() waits until a frame has been delivered
+    with frameReceived().
+
+    \note Data that was queued in the driver by the time it is read cannot
+    be split anymore. The event loop of the thread owning the serial port
+    has to keep up with the inter-frame timeout. The mode has to be enabled
+    before opening the port to take effect on the
+    \l{setIoThreadEnabled()}{I/O thread}.
+
+    \note This setting only has an effect on Unix platforms.
+
+    \sa frameReceived(), setInterFrameTimeout()
+*/
+void QSerialPort::setFrameDelimitingEnabled(bool enable)
+{
+    Q_D(QSerialPort);
+    if (!enable)
+        d->completeFrame();
+    d->frameDelimitingEnabled = enable;
+}
+
+/*!
+    \since 6.8
+
+    Returns \c true if the frame delimiting mode is enabled; otherwise
+    returns \c false.
+
+    \sa setFrameDelimitingEnabled()
+*/
+bool QSerialPort::isFrameDelimitingEnabled() const
+{
+    Q_D(const QSerialPort);
+    return d->frameDelimitingEnabled;
+}
+
+/*!
+    \since 6.8
+
+    Sets the period of silence that ends a frame in the frame delimiting
+    mode to \a timeout.
+
+    If \a timeout is zero (the default), the period is 3.5 character times,
+    computed from the current input baud rate, data bits, parity and stop
+    bits. Above 19200 baud, a fixed period of 1750 microseconds is used, as
+    recommended by the Modbus RTU specification.
+
+    \sa interFrameTimeout(), setFrameDelimitingEnabled()
+*/
+void QSerialPort::setInterFrameTimeout(std::chrono::microseconds timeout)
+{
+    Q_D(QSerialPort);
+    d->interFrameTimeout = qMax(timeout, std::chrono::microseconds::zero());
+}
+
+/*!
+    \since 6.8
+
+    Returns the period of silence that ends a frame in the frame delimiting
+    mode, as set with setInterFrameTimeout(), or zero if it is computed from
+    the current settings of the serial port.
+
+    \sa setInterFrameTimeout()
+*/
+std::chrono::microseconds QSerialPort::interFrameTimeout() const
+{
+    Q_D(const QSerialPort);
+    return d->interFrameTimeout;
+}
+
+/*!
+    \since 6.8
+
+    If \a enable is \c true, the serial port records the time at which
+    each chunk of data is read from the driver; otherwise no timestamps are
+    recorded. The timestamps can then be retrieved together with the data
+    using readWithTimestamps().
+
+    Recording is disabled by default. It has to be enabled before opening
+    the port to take effect on the \l{setIoThreadEnabled()}{I/O thread}.
+
+    \sa readWithTimestamps()
+*/
+void QSerialPort::setReceiveTimestampsEnabled(bool enable)
+{
+    Q_D(QSerialPort);
+    d->receiveTimestampsEnabled = enable;
+    if (!enable)
+        d->receiveTimestamps.clear();
+}
+
+/*!
+    \since 6.8
+
+    Returns \c true if receive timestamps are recorded; otherwise returns
+    \c false.
+
+    \sa setReceiveTimestampsEnabled()
+*/
+bool QSerialPort::isReceiveTimestampsEnabled() const
+{
+    Q_D(const QSerialPort);
+    return d->receiveTimestampsEnabled;
+}
+
+/*!
+    \class QSerialPort::TimestampedData
+    \inmodule QtSerialPort
+    \since 6.8
+
+    \brief Holds a chunk of received data and the time it was read from
+    the driver.
+
+    \ingroup shared
+
+    \sa QSerialPort::readWithTimestamps()
+*/
+
+/*!
+    Constructs an empty chunk without a timestamp.
+*/
+QSerialPort::TimestampedData::TimestampedData()
+    : d(new QSerialPortTimestampedDataPrivate)
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QSerialPort::TimestampedData::TimestampedData(const TimestampedData &other) = default;
+
+/*!
+    \fn QSerialPort::TimestampedData::TimestampedData(TimestampedData &&other)
+
+    Move-constructs the chunk from \a other.
+*/
+
+/*!
+    Assigns \a other to this chunk and returns a reference to it.
+*/
+QSerialPort::TimestampedData &QSerialPort::TimestampedData::operator=(const TimestampedData &other) = default;
+
+/*!
+    \fn QSerialPort::TimestampedData &QSerialPort::TimestampedData::operator=(TimestampedData &&other)
+
+    Move-assigns \a other to this chunk.
+*/
+
+/*!
+    Destroys the chunk.
+*/
+QSerialPort::TimestampedData::~TimestampedData() = default;
+
+/*!
+    \fn void QSerialPort::TimestampedData::swap(TimestampedData &other)
+
+    Swaps this chunk with \a other.
+*/
+
+/*!
+    Returns the time, taken from the monotonic clock, at which the data was
+    read from the driver. A default-constructed time point means that the
+    data was received while timestamps were not recorded.
+
+    \sa setTimestamp()
+*/
+std::chrono::steady_clock::time_point QSerialPort::TimestampedData::timestamp() const
+{
+    return d->timestamp;
+}
+
+/*!
+    Sets the time at which the data was read from the driver to
+    \a timestamp.
+
+    \sa timestamp()
+*/
+void QSerialPort::TimestampedData::setTimestamp(std::chrono::steady_clock::time_point timestamp)
+{
+    d->timestamp = timestamp;
+}
+
+/*!
+    Returns the received data.
+
+    \sa setData()
+*/
+QByteArray QSerialPort::TimestampedData::data() const
+{
+    return d->data;
+}
+
+/*!
+    Sets the received data to \a data.
+
+    \sa data()
+*/
+void QSerialPort::TimestampedData::setData(const QByteArray &data)
+{
+    d->data = data;
+}
+
+/*!
+    \since 6.8
+
+    Reads all data available for reading and returns it split into chunks,
+    each one with the time it was read from the driver.
+
+    Data that has already been partially read with read() or similar
+    methods keeps the timestamp of the chunk it belongs to.
+
+    \sa setReceiveTimestampsEnabled(), readAll()
+*/
+QList<QSerialPort::TimestampedData> QSerialPort::readWithTimestamps()
+{
+    Q_D(QSerialPort);
+
+    QList<TimestampedData> result;
+    const auto appendChunk = [this, &result](std::chrono::steady_clock::time_point time, qint64 size) {
+        TimestampedData chunk;
+        chunk.setTimestamp(time);
+        chunk.setData(read(size));
+        result.append(std::move(chunk));
+    };
+
+    d->dropConsumedTimestamps();
+    const QList<QSerialPortPrivate::ReceiveTimestamp> timestamps =
+            std::exchange(d->receiveTimestamps, {});
+
+    qint64 position = d->totalBytesReceived - d->buffer.size();
+    for (const QSerialPortPrivate::ReceiveTimestamp &timestamp : timestamps) {
+        if (position < timestamp.position) {
+            appendChunk(std::chrono::steady_clock::time_point(), timestamp.position - position);
+            position = timestamp.position;
+        }
+        const qint64 end = timestamp.position + timestamp.size;
+        appendChunk(timestamp.time, end - position);
+        position = end;
+    }
+
+    if (d->buffer.size() > 0)
+        appendChunk(std::chrono::steady_clock::time_point(), d->buffer.size());
+
+    return result;
+}
+
+/*!
+    \since 6.8
+
+    If \a enable is \c true, write() passes the data to the serial port
+    driver right away when no earlier data is waiting to be written, and
+    only queues the part that the driver did not accept; otherwise the
+    data is queued and written when control returns to the event loop.
+
+    This saves one event loop iteration of latency for each request of
+    request/response protocols. The bytesWritten() signal is still emitted
+    from the event loop.
+
+    The immediate write is disabled by default.
+
+    \sa isImmediateWriteEnabled(), write()
+*/
+void QSerialPort::setImmediateWriteEnabled(bool enable)
+{
+    Q_D(QSerialPort);
+    d->immediateWriteEnabled = enable;
+}
+
+/*!
+    \since 6.8
+
+    Returns \c true if data is passed to the driver directly from
+    write(); otherwise returns \c false.
+
+    \sa setImmediateWriteEnabled()
+*/
+bool QSerialPort::isImmediateWriteEnabled() const
+{
+    Q_D(const QSerialPort);
+    return d->immediateWriteEnabled;
+}
+
+/*!
+    \since 6.8
+
+    Holds back small writes until at least \a maxBytes bytes are waiting
+    to be written, or until \a maxDelay has passed since the first data
+    that was held back was written, and then passes all of them to the
+    driver at once.
+
+    This reduces the number of system calls and of USB packets for
+    applications that write a frame in many small pieces. A \a maxBytes of
+    \c 0 (the default) disables the coalescing. If \a maxDelay is zero,
+    the held back data is written when control returns to the event loop.
+    Calling flush() or waitForBytesWritten() writes the held back data
+    right away.
+
+    The coalescing has no effect on data written in the
+    \l{QIODeviceBase::}{Unbuffered} open mode, or with immediate write
+    enabled.
+
+    \sa writeCoalescingMaxBytes(), writeCoalescingMaxDelay(),
+    setImmediateWriteEnabled()
+*/
+void QSerialPort::setWriteCoalescing(qint64 maxBytes, std::chrono::milliseconds maxDelay)
+{
+    Q_D(QSerialPort);
+    d->writeCoalescingMaxBytes = qMax(maxBytes, qint64(0));
+    d->writeCoalescingMaxDelay = qMax(maxDelay, std::chrono::milliseconds::zero());
+}
+
+/*!
+    \since 6.8
+
+    Returns the number of bytes that have to be waiting before held back
+    writes are passed to the driver, or \c 0 if writes are not coalesced.
+
+    \sa setWriteCoalescing()
+*/
+qint64 QSerialPort::writeCoalescingMaxBytes() const
+{
+    Q_D(const QSerialPort);
+    return d->writeCoalescingMaxBytes;
+}
+
+/*!
+    \since 6.8
+
+    Returns the maximum time small writes are held back.
+
+    \sa setWriteCoalescing()
+*/
+std::chrono::milliseconds QSerialPort::writeCoalescingMaxDelay() const
+{
+    Q_D(const QSerialPort);
+    return d->writeCoalescingMaxDelay;
+}
+
+/*!
+    \since 6.8
+
+    Limits the rate at which data is written to the serial port to
+    \a bytesPerSecond bytes per second, allowing bursts of up to
+    \a burstSize bytes.
+
+    The limit is enforced with a token bucket: the data is written as long
+    as the bucket holds enough tokens, which refill at \a bytesPerSecond
+    up to \a burstSize. Otherwise the writes are suspended with a timer,
+    so that the event loop is not blocked. This helps with devices that
+    lose data when fed faster than their firmware can process it, even at
+    a matching baud rate and without flow control.
+
+    A \a bytesPerSecond of \c 0 (the default) disables the limit. If
+    \a burstSize is \c 0, bursts of the amount of data written in 10
+    milliseconds at the given rate are allowed.
+
+    \note This setting only has an effect on Unix platforms.
+
+    \sa writeRateLimit(), writeBurstSize(), setWriteInterFrameGap()
+*/
+void QSerialPort::setWriteRateLimit(qint64 bytesPerSecond, qint64 burstSize)
+{
+    Q_D(QSerialPort);
+    d->writeRateLimit = qMax(bytesPerSecond, qint64(0));
+    d->writeBurstSize = qMax(burstSize, qint64(0));
+    d->writeTokenTimer.invalidate();
+}
+
+/*!
+    \since 6.8
+
+    Returns the maximum number of bytes written per second, or \c 0 if the
+    rate is not limited.
+
+    \sa setWriteRateLimit()
+*/
+qint64 QSerialPort::writeRateLimit() const
+{
+    Q_D(const QSerialPort);
+    return d->writeRateLimit;
+}
+
+/*!
+    \since 6.8
+
+    Returns the maximum number of bytes written at once when the rate is
+    limited, or \c 0 if the default burst size is used.
+
+    \sa setWriteRateLimit()
+*/
+qint64 QSerialPort::writeBurstSize() const
+{
+    Q_D(const QSerialPort);
+    return d->writeBurstSize;
+}
+
+/*!
+    \since 6.8
+
+    Sets the minimum idle time of the transmission line between two frames
+    to \a gap, where the data passed to each call of write() is a frame.
+    The gap starts when the driver is estimated to have transmitted the
+    last byte of the previous frame.
+
+    Urgent data written with the UrgentPriority is not delayed by the gap.
+    A \a gap of zero (the default) writes the frames back to back. The data
+    which is waiting to be written when the gap is enabled is one frame.
+
+    \note This setting only has an effect on Unix platforms.
+
+    \sa writeInterFrameGap(), setWriteRateLimit()
+*/
+void QSerialPort::setWriteInterFrameGap(std::chrono::microseconds gap)
+{
+    Q_D(QSerialPort);
+    const bool wasEnabled = d->writeInterFrameGap.count() > 0;
+    d->writeInterFrameGap = qMax(gap, std::chrono::microseconds::zero());
+    if (d->writeInterFrameGap.count() == 0)
+        d->writeFrameSizes.clear();
+    else if (!wasEnabled && !d->writeBuffer.isEmpty())
+        d->writeFrameSizes.append(d->writeBuffer.size());
+}
+
+/*!
+    \since 6.8
+
+    Returns the minimum idle time between two written frames.
+
+    \sa setWriteInterFrameGap()
+*/
+std::chrono::microseconds QSerialPort::writeInterFrameGap() const
+{
+    Q_D(const QSerialPort);
+    return d->writeInterFrameGap;
+}
+
+/*!
+    \since 6.8
+
+    If \a enabled is \c true, the serial port receives the data on an
+    internal I/O thread, which hands it over to the thread owning the port.
+    The reception then keeps up with the port, even when the owner thread
+    is too busy to process its events in time, and the driver buffer would
+    overflow otherwise. The data, the readyRead() signal, and the rest of
+    the API stay in the owner thread.
+
+    The setting takes effect when the port is opened for reading, and is
+    ignored in \l{QIODevice::}{Unbuffered} mode. It is disabled by default.
+
+    The I/O thread is not used either if receive timestamps or the frame
+    delimiting mode are enabled when the port is opened, as both depend on
+    the time at which the data is read from the driver. If they are enabled
+    later on, they refer to the time at which the owner thread takes the
+    data over from the I/O thread.
+
+    \note This setting only has an effect on Unix platforms.
+
+    \sa isIoThreadEnabled()
+*/
+void QSerialPort::setIoThreadEnabled(bool enabled)
+{
+    Q_D(QSerialPort);
+    d->ioThreadEnabled = enabled;
+}
+
+/*!
+    \since 6.8
+
+    Returns \c true if the data is received on an internal I/O thread.
+
+    \sa setIoThreadEnabled()
+*/
+bool QSerialPort::isIoThreadEnabled() const
+{
+    Q_D(const QSerialPort);
+    return d->ioThreadEnabled;
+}
+
+/*!
+    \since 6.8
+
+    If \a enabled is \c true, the serial port is serviced by a reactor
+    shared by all the ports of the same thread that enable it. The
+    reactor waits for all of them with a single epoll instance, watched by
+    a single socket notifier, and handles the ready ports in batches. This
+    reduces the event dispatcher overhead when a thread serves many ports,
+    compared to the pair of notifiers each port uses otherwise.
+
+    The setting takes effect when the port is opened, and is ignored when
+    the I/O thread is enabled. The port must not be moved to another thread
+    while it is open. It is disabled by default.
+
+    \note This setting only has an effect on Linux.
+
+    \sa isSharedReactorEnabled(), setIoThreadEnabled()
+*/
+void QSerialPort::setSharedReactorEnabled(bool enabled)
+{
+    Q_D(QSerialPort);
+    d->sharedReactorEnabled = enabled;
+}
+
+/*!
+    \since 6.8
+
+    Returns \c true if the serial port is serviced by the shared reactor of
+    its thread.
+
+    \sa setSharedReactorEnabled()
+*/
+bool QSerialPort::isSharedReactorEnabled() const
+{
+    Q_D(const QSerialPort);
+    return d->sharedReactorEnabled;
+}
+
+/*!
+    \since 6.8
+
+    Sets the time that waitForReadyRead() spins checking the driver for
+    received data to \a duration, before it falls back to sleeping until
+    the data arrives. Spinning trades CPU time for a lower wakeup latency,
+    so it is only useful for threads that have a CPU core of their own.
+
+    A \a duration of zero (the default) disables the spinning. Setting the
+    duration resets the busyPollHitCount() and busyPollFallbackCount().
+
+    \note This setting only has an effect on Unix platforms.
+
+    \sa busyPollDuration(), waitForReadyRead()
+*/
+void QSerialPort::setBusyPollDuration(std::chrono::microseconds duration)
+{
+    Q_D(QSerialPort);
+    d->busyPollDuration = qMax(duration, std::chrono::microseconds::zero());
+    d->busyPollHits = 0;
+    d->busyPollFallbacks = 0;
+}
+
+/*!
+    \since 6.8
+
+    Returns the time that waitForReadyRead() spins before it sleeps.
+
+    \sa setBusyPollDuration()
+*/
+std::chrono::microseconds QSerialPort::busyPollDuration() const
+{
+    Q_D(const QSerialPort);
+    return d->busyPollDuration;
+}
+
+/*!
+    \since 6.8
 
-    if (directions & Input)
-        d->buffer.clear();
-    if (directions & Output)
-        d->writeBuffer.clear();
-    return d->clear(directions);
+    Returns how many times the data arrived while waitForReadyRead() was
+    spinning.
+
+    \sa busyPollFallbackCount(), setBusyPollDuration()
+*/
+qint64 QSerialPort::busyPollHitCount() const
+{
+    Q_D(const QSerialPort);
+    return d->busyPollHits;
 }
 
 /*!
-    \property QSerialPort::error
-    \brief the error status of the serial port
+    \since 6.8
 
-    The I/O device status returns an error code. For example, if open()
-    returns \c false, or a read/write operation returns \c -1, this property can
-    be used to figure out the reason why the operation failed.
+    Returns how many times waitForReadyRead() spun for the whole busy poll
+    duration without receiving data, and fell back to sleeping.
 
-    The error code is set to the default QSerialPort::NoError after a call to
-    clearError()
+    \sa busyPollHitCount(), setBusyPollDuration()
 */
-QSerialPort::SerialPortError QSerialPort::error() const
+qint64 QSerialPort::busyPollFallbackCount() const
 {
     Q_D(const QSerialPort);
-    return d->error;
+    return d->busyPollFallbacks;
 }
 
-void QSerialPort::clearError()
+/*!
+    \since 6.8
+
+    Sets the line delimiter used by canReadDelimitedLine() and
+    readDelimitedLine() to \a delimiter. It can be a single byte, such as \c{';'}, or an
+    arbitrary byte sequence, such as \c{"\r\n"}. An empty \a delimiter
+    restores the default.
+
+    The buffered data is scanned incrementally: the bytes already examined
+    by previous calls are not scanned again, which keeps line-oriented
+    protocols cheap even if a line arrives in many small chunks.
+
+    The default delimiter is \c{'\n'}.
+
+    \note QIODevice::readLine() and canReadLine() always look for the next
+    \c{'\n'}, use readDelimitedLine() and canReadDelimitedLine() to honor
+    the configured delimiter.
+
+    \sa lineDelimiter(), readDelimitedLine()
+*/
+void QSerialPort::setLineDelimiter(const QByteArray &delimiter)
 {
     Q_D(QSerialPort);
-    d->setError(QSerialPortErrorInfo(QSerialPort::NoError));
+    d->lineDelimiter = delimiter.isEmpty() ? QByteArray(1, '\n') : delimiter;
+    d->lineScanPosition = 0;
 }
 
-QBindable<QSerialPort::SerialPortError> QSerialPort::bindableError() const
+/*!
+    \since 6.8
+
+    Returns the line delimiter used by canReadDelimitedLine() and
+    readDelimitedLine().
+
+    \sa setLineDelimiter()
+*/
+QByteArray QSerialPort::lineDelimiter() const
 {
-    return &d_func()->error;
+    Q_D(const QSerialPort);
+    return d->lineDelimiter;
 }
 
 /*!
-    \fn void QSerialPort::errorOccurred(SerialPortError error)
-    \since 5.8
+    \since 6.8
 
-    This signal is emitted when an error occurs in the serial port.
-    The specified \a error describes the type of error that occurred.
+    Reads a line terminated by lineDelimiter() from the serial port, but
+    not more than \a maxSize bytes, and returns the result as a byte array.
+    The delimiter is included in the returned data. If \a maxSize is 0,
+    the line can be of any length.
 
-    \sa QSerialPort::error
+    If no complete line is buffered, all the available data is returned,
+    as with readLine(). Use canReadDelimitedLine() to check for a complete
+    line first.
+
+    \sa setLineDelimiter(), canReadDelimitedLine()
 */
+QByteArray QSerialPort::readDelimitedLine(qint64 maxSize)
+{
+    Q_D(QSerialPort);
+
+    if (maxSize < 0) {
+        qWarning("%s: Called with maxSize < 0", Q_FUNC_INFO);
+        return QByteArray();
+    }
+
+    qint64 lineSize = d->findLineEnd();
+    if (lineSize < 0)
+        lineSize = bytesAvailable();
+    if (maxSize > 0)
+        lineSize = qMin(lineSize, maxSize);
+
+    const QByteArray line = read(lineSize);
+    d->updateReadThrottling();
+    return line;
+}
 
 /*!
-    Returns the size of the internal read buffer. This limits the
-    amount of data that the client can receive before calling the read()
-    or readAll() methods.
+    \since 6.8
 
-    A read buffer size of \c 0 (the default) means that the buffer has
-    no size limit, ensuring that no data is lost.
+    Returns \c true if a line of data terminated by lineDelimiter() can be
+    read from the serial port with readDelimitedLine(); otherwise returns
+    \c false.
 
-    \sa setReadBufferSize(), read()
+    \sa readDelimitedLine(), canReadLine()
 */
-qint64 QSerialPort::readBufferSize() const
+bool QSerialPort::canReadDelimitedLine() const
 {
     Q_D(const QSerialPort);
-    return d->readBufferMaxSize;
+    return d->findLineEnd() >= 0;
 }
 
 /*!
-    Sets the size of QSerialPort's internal read buffer to be \a
-    size bytes.
+    \since 6.8
 
-    If the buffer size is limited to a certain size, QSerialPort
-    will not buffer more than this size of data. The special case of a buffer
-    size of \c 0 means that the read buffer is unlimited and all
-    incoming data is buffered. This is the default.
+    Writes at most \a maxSize bytes of data from \a data to the serial port
+    with the given \a priority. Returns the number of bytes that were
+    actually written, or \c -1 if an error occurred.
 
-    This option is useful if the data is only read at certain points
-    in time (for instance in a real-time streaming application) or if the serial
-    port should be protected against receiving too much data, which may
-    eventually cause the application to run out of memory.
+    Data of UrgentPriority is kept in a queue of its own, which is written
+    before the data of NormalPriority that is still waiting to be written.
+    The switch happens between two writes to the driver, so urgent data,
+    such as control commands, does not wait for a large backlog of bulk
+    data to be written. Urgent data keeps its order relative to other
+    urgent data.
 
-    \sa readBufferSize(), read()
+    \sa bytesToWrite(), QIODevice::write()
 */
-void QSerialPort::setReadBufferSize(qint64 size)
+qint64 QSerialPort::write(const char *data, qint64 maxSize, WritePriority priority)
 {
     Q_D(QSerialPort);
-    d->readBufferMaxSize = size;
-    if (isReadable())
-        d->startAsyncRead();
+
+    if (priority == NormalPriority)
+        return QIODevice::write(data, maxSize);
+
+    if (!isOpen()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        qWarning("%s: device not open", Q_FUNC_INFO);
+        return qint64(-1);
+    }
+
+    if (!isWritable()) {
+        qWarning("%s: ReadOnly device", Q_FUNC_INFO);
+        return qint64(-1);
+    }
+
+    if (maxSize < 0) {
+        qWarning("%s: Called with maxSize < 0", Q_FUNC_INFO);
+        return qint64(-1);
+    }
+
+    return d->writeUrgentData(data, maxSize);
+}
+
+/*!
+    \since 6.8
+    \overload
+
+    Writes the content of \a data to the serial port with the given
+    \a priority. Returns the number of bytes that were actually written,
+    or \c -1 if an error occurred.
+*/
+qint64 QSerialPort::write(const QByteArray &data, WritePriority priority)
+{
+    return write(data.constData(), data.size(), priority);
 }
 
 /*!
@@ -1040,7 +2615,13 @@ bool QSerialPort::isSequential() const
 */
 qint64 QSerialPort::bytesAvailable() const
 {
-    return QIODevice::bytesAvailable();
+    qint64 availableBytes = QIODevice::bytesAvailable();
+#if defined(Q_OS_UNIX)
+    // In the unbuffered mode the data stays in the driver until it is read
+    if (openMode() & Unbuffered)
+        availableBytes += qMax(d_func()->queuedBytesCount(QSerialPort::Input), qint64(0));
+#endif
+    return availableBytes;
 }
 
 /*!
@@ -1054,24 +2635,152 @@ qint64 QSerialPort::bytesAvailable() const
 */
 qint64 QSerialPort::bytesToWrite() const
 {
-    qint64 pendingBytes = QIODevice::bytesToWrite();
+    qint64 pendingBytes = QIODevice::bytesToWrite() + d_func()->urgentWriteBuffer.size();
 #if defined(Q_OS_WIN32)
     pendingBytes += d_func()->writeChunkBuffer.size();
 #endif
     return pendingBytes;
 }
 
+/*!
+    \since 6.8
+
+    Returns the number of bytes that have been passed to the serial port
+    driver but not yet transmitted, as opposed to bytesToWrite(), which
+    only counts the data that has not been passed to the driver yet.
+    Together they give the depth of the whole transmit queue.
+
+    Returns \c -1 if the port is not open or the driver cannot tell.
+
+    \sa bytesInDriverRx(), bytesToWrite()
+*/
+qint64 QSerialPort::bytesInDriverTx() const
+{
+    Q_D(const QSerialPort);
+    if (!isOpen())
+        return qint64(-1);
+    return d->queuedBytesCount(QSerialPort::Output);
+}
+
+/*!
+    \since 6.8
+
+    Returns the number of bytes that have been received by the serial port
+    driver but not yet read into the internal read buffer, as opposed to
+    bytesAvailable(), which counts the data in the read buffer. Together
+    they give the depth of the whole receive queue.
+
+    In the \l{QIODevice::}{Unbuffered} mode, bytesAvailable() counts the
+    data queued in the driver already, so this function returns \c 0.
+
+    Returns \c -1 if the port is not open or the driver cannot tell.
+
+    \sa bytesInDriverTx(), bytesAvailable()
+*/
+qint64 QSerialPort::bytesInDriverRx() const
+{
+    Q_D(const QSerialPort);
+    if (!isOpen())
+        return qint64(-1);
+    const qint64 queuedBytes = d->queuedBytesCount(QSerialPort::Input);
+#if defined(Q_OS_UNIX)
+    if (queuedBytes >= 0 && (openMode() & Unbuffered))
+        return qint64(0);
+#endif
+    return queuedBytes;
+}
+
 /*!
     \reimp
 
     Returns \c true if a line of data can be read from the serial port;
     otherwise returns \c false.
 
-    \sa readLine()
+    As readLine(), this function always looks for \c{'\n'}, regardless of
+    lineDelimiter(). Only the data received since the previous call is
+    scanned.
+
+    \sa readLine(), canReadDelimitedLine()
 */
 bool QSerialPort::canReadLine() const
 {
-    return QIODevice::canReadLine();
+    Q_D(const QSerialPort);
+    return d->findDelimiter("\n", &d->newlineScanPosition) >= 0;
+}
+
+/*!
+    \since 6.8
+
+    Returns a view of the first contiguous block of data held in the internal
+    read buffer, without copying or consuming it. An empty view is returned
+    if no data is buffered, or if the serial port is not open for reading.
+
+    The view only remains valid until the next read from the serial port or
+    until control returns to the event loop, whichever comes first.
+
+    \sa takeChunk(), bytesAvailable()
+*/
+QByteArrayView QSerialPort::peekChunk() const
+{
+    Q_D(const QSerialPort);
+
+    if (!isReadable())
+        return QByteArrayView();
+
+    if (d->transactionStarted) {
+        qint64 length = 0;
+        const char *data = d->buffer.readPointerAtPosition(d->transactionPos, length);
+        return QByteArrayView(data, length);
+    }
+
+    return QByteArrayView(d->buffer.readPointer(), d->buffer.nextDataBlockSize());
+}
+
+/*!
+    \since 6.8
+
+    Removes the first contiguous block of data from the internal read buffer
+    and returns it. The returned array shares its storage with the buffer
+    chunk it was taken from, so no data is copied. Use this method in
+    combination with peekChunk() to process high rate streams without the
+    extra copy performed by read() and readAll().
+
+    Returns an empty array if no data is buffered.
+
+    \note The serial port has to be open before trying to take any buffered
+    data; otherwise returns an empty array and sets the NotOpenError error code.
+    Like read(), it returns an empty array with a warning if the serial port is
+    open for writing only.
+
+    \sa peekChunk(), readAll()
+*/
+QByteArray QSerialPort::takeChunk()
+{
+    Q_D(QSerialPort);
+
+    if (!isOpen()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        qWarning("%s: device not open", Q_FUNC_INFO);
+        return QByteArray();
+    }
+
+    if (!isReadable()) {
+        qWarning("%s: WriteOnly device", Q_FUNC_INFO);
+        return QByteArray();
+    }
+
+    // Let QIODevice keep track of the data read within a transaction.
+    if (d->transactionStarted)
+        return read(peekChunk().size());
+
+    const QByteArray chunk = d->buffer.read();
+    d->updateReadThrottling();
+
+    // The read notifications might have been disabled by a limited
+    // read buffer size, so restart them as readData() does.
+    d->startAsyncRead();
+
+    return chunk;
 }
 
 /*!
@@ -1094,6 +2803,145 @@ bool QSerialPort::waitForReadyRead(int msecs)
     return d->waitForReadyRead(msecs);
 }
 
+/*!
+    \since 6.8
+
+    Blocks until at least \a count bytes are available for reading, or
+    until \a msecs milliseconds have passed. If \a msecs is -1, this
+    function will not time out.
+
+    Unlike calling waitForReadyRead() in a loop, this function keeps
+    receiving data without returning for every chunk that arrives. The
+    \l{QIODevice::}{readyRead()} signal is still emitted for every chunk.
+
+    Returns \c true if \a count bytes are available; otherwise returns
+    \c false (if an error occurred or the operation timed out). If \a count
+    exceeds the read buffer size, returns \c false immediately and sets the
+    UnsupportedOperationError error code.
+
+    \note This function is not supported for ports opened in
+    \l{QIODevice::}{Unbuffered} mode.
+
+    \sa waitForDelimiter(), waitForReadyRead(), bytesAvailable()
+*/
+bool QSerialPort::waitForBytesAvailable(qint64 count, int msecs)
+{
+    Q_D(QSerialPort);
+
+    if (!isOpen()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        qWarning("%s: device not open", Q_FUNC_INFO);
+        return false;
+    }
+
+    if (openMode() & Unbuffered) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                                         tr("Not supported in unbuffered mode")));
+        return false;
+    }
+
+    if (d->readBufferMaxSize > 0 && count > d->readBufferMaxSize) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                                         tr("Count exceeds the read buffer size")));
+        return false;
+    }
+
+    return d->waitForBytesAvailable(count, QDeadlineTimer(msecs));
+}
+
+/*!
+    \since 6.8
+
+    Blocks until \a delimiter is available for reading, or until \a msecs
+    milliseconds have passed. If \a msecs is -1, this function will not
+    time out.
+
+    Unlike calling waitForReadyRead() in a loop, this function keeps
+    receiving data without returning for every chunk that arrives, and
+    only scans the newly received data for the delimiter.
+
+    Returns \c true if the read buffer contains \a delimiter; otherwise
+    returns \c false (if an error occurred or the operation timed out).
+
+    \note This function is not supported for ports opened in
+    \l{QIODevice::}{Unbuffered} mode.
+
+    \sa waitForBytesAvailable(), readDelimitedLine()
+*/
+bool QSerialPort::waitForDelimiter(const QByteArray &delimiter, int msecs)
+{
+    Q_D(QSerialPort);
+
+    if (!isOpen()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        qWarning("%s: device not open", Q_FUNC_INFO);
+        return false;
+    }
+
+    if (delimiter.isEmpty()) {
+        qWarning("%s: empty delimiter", Q_FUNC_INFO);
+        return false;
+    }
+
+    if (openMode() & Unbuffered) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                                         tr("Not supported in unbuffered mode")));
+        return false;
+    }
+
+    return d->waitForDelimiter(delimiter, QDeadlineTimer(msecs));
+}
+
+/*!
+    \since 6.8
+
+    Blocks until new data is available for reading on at least one of the
+    serial ports in \a ports, or until \a msecs milliseconds have passed.
+    If \a msecs is -1, this function will not time out.
+
+    All the ports are waited on at once. Pending writes of every port are
+    continued while waiting, and every port that receives data emits
+    \l{QIODevice::}{readyRead()} as waitForReadyRead() does.
+
+    Returns the ports that have received new data. If the list is empty,
+    the operation timed out or failed, and error() of the affected ports
+    tells why. Ports that are not open for reading are ignored.
+
+    All the ports must belong to the calling thread.
+
+    \note This function is only supported on Unix platforms.
+
+    \sa waitForReadyRead()
+*/
+QList<QSerialPort *> QSerialPort::waitForAnyReadyRead(const QList<QSerialPort *> &ports, int msecs)
+{
+    return QSerialPortPrivate::waitForAnyReadyRead(ports, QDeadlineTimer(msecs));
+}
+
+/*!
+    \since 6.8
+    \threadsafe
+
+    Interrupts a blocking wait of the serial port, such as
+    waitForReadyRead(), waitForBytesWritten(), waitForTransmitted() or
+    waitForAnyReadyRead(), which is in progress in another thread. The
+    interrupted wait returns \c false, or no ports, and sets the
+    TimeoutError. If no wait is in progress, the next one returns
+    immediately.
+
+    This allows a worker thread to wait without a timeout, and still stop
+    without delay. The port must not be closed concurrently.
+
+    \note This function only has an effect on Unix platforms.
+
+    \sa waitForReadyRead(), waitForBytesWritten()
+*/
+void QSerialPort::interruptWait()
+{
+    Q_D(QSerialPort);
+    d->interruptWait();
+}
+
 /*!
     \fn Handle QSerialPort::handle() const
     \since 5.2
@@ -1123,6 +2971,84 @@ bool QSerialPort::waitForBytesWritten(int msecs)
     return d->waitForBytesWritten(msecs);
 }
 
+/*!
+    \since 6.8
+
+    This function blocks until all data written to the serial port has left
+    the transmitter, that is, until nothing is waiting to be written and the
+    output queue of the driver is empty. Where the driver reports the state
+    of the UART transmitter, its shift register has to be empty as well. The
+    function will timeout after \a msecs milliseconds; the default timeout is
+    30000 milliseconds. If \a msecs is -1, this function will not time out.
+
+    Half-duplex protocols can call this function before turning the bus
+    around, instead of sleeping for an estimated transmission time.
+
+    The function returns \c true if all data has been transmitted; otherwise
+    it returns \c false (if an error occurred, the operation timed out or
+    it was interrupted with interruptWait()).
+
+    \note The serial port has to be open before waiting for the data to be
+    transmitted; otherwise returns \c false and sets the NotOpenError error
+    code.
+
+    \sa allBytesTransmitted(), waitForBytesWritten()
+*/
+bool QSerialPort::waitForTransmitted(int msecs)
+{
+    Q_D(QSerialPort);
+
+    if (!isOpen()) {
+        d->setError(QSerialPortErrorInfo(QSerialPort::NotOpenError));
+        qWarning("%s: device not open", Q_FUNC_INFO);
+        return false;
+    }
+
+    const QDeadlineTimer deadline(msecs);
+    while (bytesToWrite() > 0) {
+        if (!d->waitForBytesWritten(int(deadline.remainingTime())))
+            return false;
+    }
+
+    return d->waitForTransmitted(deadline);
+}
+
+/*!
+    \fn void QSerialPort::frameReceived(const QByteArray &frame)
+    \since 6.8
+
+    This signal is emitted in the frame delimiting mode when a complete
+    \a frame has been received, that is, when the line has been idle for
+    interFrameTimeout() after the last byte of the frame.
+
+    \sa setFrameDelimitingEnabled()
+*/
+
+/*!
+    \fn void QSerialPort::allBytesTransmitted()
+    \since 6.8
+
+    This signal is emitted when all data written to the serial port has
+    left the transmitter, as opposed to \l{QIODevice::}{bytesWritten()},
+    which is emitted when the data has been passed to the driver. The
+    output queue of the driver is polled at intervals derived from the
+    amount of queued data and the baud rate, only while this signal is
+    connected.
+
+    \sa waitForTransmitted()
+*/
+
+/*!
+    \fn void QSerialPort::readThrottledChanged(bool throttled)
+    \since 6.8
+
+    This signal is emitted when the sender is throttled or resumed because
+    the internal read buffer crossed one of its watermarks. The \a throttled
+    argument is \c true when the high watermark was reached.
+
+    \sa setReadBufferWatermarks(), isReadThrottled()
+*/
+
 /*!
     \property QSerialPort::breakEnabled
     \since 5.5
@@ -1182,8 +3108,16 @@ QBindable<bool> QSerialPort::bindableIsBreakEnabled()
 */
 qint64 QSerialPort::readData(char *data, qint64 maxSize)
 {
+#if defined(Q_OS_UNIX)
+    if (openMode() & Unbuffered)
+        return d_func()->readUnbuffered(data, maxSize);
+#else
     Q_UNUSED(data);
     Q_UNUSED(maxSize);
+#endif
+
+    // The buffer has been read, so the sender may need to be resumed
+    d_func()->updateReadThrottling();
 
     // In any case we need to start the notifications if they were
     // disabled by the read handler. If enabled, next call does nothing.
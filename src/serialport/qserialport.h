@@ -7,13 +7,18 @@
 
 #include <QtCore/qiodevice.h>
 #include <QtCore/qproperty.h>
+#include <QtCore/qshareddata.h>
 
 #include <QtSerialPort/qserialportglobal.h>
 
+#include <chrono>
+
 QT_BEGIN_NAMESPACE
 
 class QSerialPortInfo;
 class QSerialPortPrivate;
+class QSerialPortRs485SettingsPrivate;
+class QSerialPortTimestampedDataPrivate;
 
 class Q_SERIALPORT_EXPORT QSerialPort : public QIODevice
 {
@@ -123,6 +128,74 @@ public:
     };
     Q_ENUM(SerialPortError)
 
+    enum ReadChunkPolicy {
+        FixedReadChunk,
+        AdaptiveReadChunk
+    };
+    Q_ENUM(ReadChunkPolicy)
+
+    enum WritePriority {
+        NormalPriority,
+        UrgentPriority
+    };
+    Q_ENUM(WritePriority)
+
+    class Q_SERIALPORT_EXPORT TimestampedData
+    {
+    public:
+        TimestampedData();
+        TimestampedData(const TimestampedData &other);
+        TimestampedData(TimestampedData &&other) noexcept = default;
+        TimestampedData &operator=(const TimestampedData &other);
+        QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(TimestampedData)
+        ~TimestampedData();
+
+        void swap(TimestampedData &other) noexcept { d.swap(other.d); }
+
+        std::chrono::steady_clock::time_point timestamp() const;
+        void setTimestamp(std::chrono::steady_clock::time_point timestamp);
+
+        QByteArray data() const;
+        void setData(const QByteArray &data);
+
+    private:
+        QSharedDataPointer<QSerialPortTimestampedDataPrivate> d;
+    };
+
+    class Q_SERIALPORT_EXPORT Rs485Settings
+    {
+    public:
+        Rs485Settings();
+        Rs485Settings(const Rs485Settings &other);
+        Rs485Settings(Rs485Settings &&other) noexcept = default;
+        Rs485Settings &operator=(const Rs485Settings &other);
+        QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(Rs485Settings)
+        ~Rs485Settings();
+
+        void swap(Rs485Settings &other) noexcept { d.swap(other.d); }
+
+        bool isEnabled() const;
+        void setEnabled(bool enabled);
+
+        bool rtsOnSend() const;
+        void setRtsOnSend(bool set);
+
+        bool rtsAfterSend() const;
+        void setRtsAfterSend(bool set);
+
+        bool receiveDuringTransmit() const;
+        void setReceiveDuringTransmit(bool receive);
+
+        std::chrono::milliseconds delayBeforeSend() const;
+        void setDelayBeforeSend(std::chrono::milliseconds delay);
+
+        std::chrono::milliseconds delayAfterSend() const;
+        void setDelayAfterSend(std::chrono::milliseconds delay);
+
+    private:
+        QSharedDataPointer<QSerialPortRs485SettingsPrivate> d;
+    };
+
     explicit QSerialPort(QObject *parent = nullptr);
     explicit QSerialPort(const QString &name, QObject *parent = nullptr);
     explicit QSerialPort(const QSerialPortInfo &info, QObject *parent = nullptr);
@@ -158,6 +231,9 @@ public:
     FlowControl flowControl() const;
     QBindable<FlowControl> bindableFlowControl();
 
+    bool setRs485Settings(const Rs485Settings &settings);
+    Rs485Settings rs485Settings() const;
+
     bool setDataTerminalReady(bool set);
     bool isDataTerminalReady();
 
@@ -176,14 +252,83 @@ public:
     qint64 readBufferSize() const;
     void setReadBufferSize(qint64 size);
 
+    void setReadBufferWatermarks(qint64 lowMark, qint64 highMark);
+    qint64 readBufferLowWatermark() const;
+    qint64 readBufferHighWatermark() const;
+    bool isReadThrottled() const;
+
+    ReadChunkPolicy readChunkPolicy() const;
+    void setReadChunkPolicy(ReadChunkPolicy policy);
+
+    void setReadDrainLimits(qint64 maxBytes,
+                            std::chrono::microseconds maxDuration = std::chrono::microseconds::zero());
+    qint64 readDrainMaxBytes() const;
+    std::chrono::microseconds readDrainMaxDuration() const;
+
+    void setReadyReadThreshold(qint64 bytes, std::chrono::milliseconds maxDelay);
+    qint64 readyReadThreshold() const;
+    std::chrono::milliseconds readyReadMaxDelay() const;
+
+    void setFrameDelimitingEnabled(bool enable);
+    bool isFrameDelimitingEnabled() const;
+    void setInterFrameTimeout(std::chrono::microseconds timeout);
+    std::chrono::microseconds interFrameTimeout() const;
+
+    void setReceiveTimestampsEnabled(bool enable);
+    bool isReceiveTimestampsEnabled() const;
+    QList<TimestampedData> readWithTimestamps();
+
+    void setImmediateWriteEnabled(bool enable);
+    bool isImmediateWriteEnabled() const;
+
+    void setWriteCoalescing(qint64 maxBytes, std::chrono::milliseconds maxDelay);
+    qint64 writeCoalescingMaxBytes() const;
+    std::chrono::milliseconds writeCoalescingMaxDelay() const;
+
+    void setWriteRateLimit(qint64 bytesPerSecond, qint64 burstSize = 0);
+    qint64 writeRateLimit() const;
+    qint64 writeBurstSize() const;
+    void setWriteInterFrameGap(std::chrono::microseconds gap);
+    std::chrono::microseconds writeInterFrameGap() const;
+
+    void setIoThreadEnabled(bool enabled);
+    bool isIoThreadEnabled() const;
+    void setSharedReactorEnabled(bool enabled);
+    bool isSharedReactorEnabled() const;
+
+    void setBusyPollDuration(std::chrono::microseconds duration);
+    std::chrono::microseconds busyPollDuration() const;
+    qint64 busyPollHitCount() const;
+    qint64 busyPollFallbackCount() const;
+
+    void setLineDelimiter(const QByteArray &delimiter);
+    QByteArray lineDelimiter() const;
+    QByteArray readDelimitedLine(qint64 maxSize = 0);
+    bool canReadDelimitedLine() const;
+
+    using QIODevice::write;
+    qint64 write(const char *data, qint64 maxSize, WritePriority priority);
+    qint64 write(const QByteArray &data, WritePriority priority);
+
     bool isSequential() const override;
 
     qint64 bytesAvailable() const override;
     qint64 bytesToWrite() const override;
+    qint64 bytesInDriverTx() const;
+    qint64 bytesInDriverRx() const;
     bool canReadLine() const override;
 
+    QByteArrayView peekChunk() const;
+    QByteArray takeChunk();
+
     bool waitForReadyRead(int msecs = 30000) override;
+    bool waitForBytesAvailable(qint64 count, int msecs = 30000);
+    bool waitForDelimiter(const QByteArray &delimiter, int msecs = 30000);
+    static QList<QSerialPort *> waitForAnyReadyRead(const QList<QSerialPort *> &ports,
+                                                    int msecs = 30000);
+    void interruptWait();
     bool waitForBytesWritten(int msecs = 30000) override;
+    bool waitForTransmitted(int msecs = 30000);
 
     bool setBreakEnabled(bool set = true);
     bool isBreakEnabled() const;
@@ -201,6 +346,9 @@ Q_SIGNALS:
     void requestToSendChanged(bool set);
     void errorOccurred(QSerialPort::SerialPortError error);
     void breakEnabledChanged(bool set);
+    void frameReceived(const QByteArray &frame);
+    void readThrottledChanged(bool throttled);
+    void allBytesTransmitted();
 
 protected:
     qint64 readData(char *data, qint64 maxSize) override;
@@ -219,6 +367,9 @@ private:
 Q_DECLARE_OPERATORS_FOR_FLAGS(QSerialPort::Directions)
 Q_DECLARE_OPERATORS_FOR_FLAGS(QSerialPort::PinoutSignals)
 
+Q_DECLARE_SHARED(QSerialPort::TimestampedData)
+Q_DECLARE_SHARED(QSerialPort::Rs485Settings)
+
 QT_END_NAMESPACE
 
 #endif // QSERIALPORT_H
@@ -19,7 +19,11 @@
 
 #include "qserialport.h"
 
+#include <qatomic.h>
 #include <qdeadlinetimer.h>
+#include <qelapsedtimer.h>
+#include <qmutex.h>
+#include <qthread.h>
 
 #include <private/qiodevice_p.h>
 #include <private/qproperty_p.h>
@@ -74,11 +78,51 @@ QT_BEGIN_NAMESPACE
 class QWinOverlappedIoNotifier;
 class QTimer;
 class QSocketNotifier;
+class QSerialPortReactor;
 
 #if defined(Q_OS_UNIX)
 QString serialPortLockFilePath(const QString &portName);
+
+// Hands the received data over from the I/O thread (the single producer)
+// to the thread owning the port (the single consumer) without locking.
+class QSerialPortReceiveRing
+{
+public:
+    explicit QSerialPortReceiveRing(quintptr capacity);
+
+    quintptr size() const;
+    bool isFull() const { return size() == capacity; }
+
+    qint64 readFromDescriptor(int descriptor);
+    qint64 read(char *data, qint64 maxSize);
+    void clear();
+
+private:
+    const quintptr capacity; // a power of two
+    const std::unique_ptr<char[]> ring;
+    QAtomicInteger<quintptr> head; // advanced by the producer only
+    QAtomicInteger<quintptr> tail; // advanced by the consumer only
+};
 #endif
 
+class QSerialPortTimestampedDataPrivate : public QSharedData
+{
+public:
+    std::chrono::steady_clock::time_point timestamp;
+    QByteArray data;
+};
+
+class QSerialPortRs485SettingsPrivate : public QSharedData
+{
+public:
+    bool enabled = false;
+    bool rtsOnSend = true;
+    bool rtsAfterSend = false;
+    bool receiveDuringTransmit = false;
+    std::chrono::milliseconds delayBeforeSend{0};
+    std::chrono::milliseconds delayAfterSend{0};
+};
+
 class QSerialPortErrorInfo
 {
 public:
@@ -103,6 +147,8 @@ public:
     bool setDataTerminalReady(bool set);
     bool setRequestToSend(bool set);
 
+    bool setRs485Settings(const QSerialPort::Rs485Settings &settings);
+
     bool flush();
     bool clear(QSerialPort::Directions directions);
 
@@ -123,7 +169,10 @@ public:
 
     void setError(const QSerialPortErrorInfo &errorInfo);
 
+    QTimer *ensurePreciseTimer(QTimer *&timer, void (QSerialPortPrivate::*slot)());
+
     qint64 writeData(const char *data, qint64 maxSize);
+    qint64 writeUrgentData(const char *data, qint64 maxSize);
 
     bool initialize(QIODevice::OpenMode mode);
 
@@ -133,6 +182,88 @@ public:
     static QList<qint32> standardBaudRates();
 
     qint64 readBufferMaxSize = 0;
+    QSerialPort::ReadChunkPolicy readChunkPolicy = QSerialPort::FixedReadChunk;
+    qint64 readDrainMaxBytes = 0;
+    std::chrono::microseconds readDrainMaxDuration{0};
+    qint64 readyReadThreshold = 0;
+    std::chrono::milliseconds readyReadMaxDelay{0};
+
+    void updateReadThrottling();
+    void setReadThrottled(bool throttled);
+
+    qint64 readLowWatermark = 0;
+    qint64 readHighWatermark = 0;
+    bool readThrottled = false;
+    bool senderThrottlingFailed = false;
+
+    bool ioThreadEnabled = false;
+    bool sharedReactorEnabled = false;
+    std::chrono::microseconds busyPollDuration{0};
+    qint64 busyPollHits = 0;
+    qint64 busyPollFallbacks = 0;
+
+    QRingBuffer urgentWriteBuffer;
+    bool immediateWriteEnabled = false;
+    qint64 writeCoalescingMaxBytes = 0;
+    std::chrono::milliseconds writeCoalescingMaxDelay{0};
+
+    qint64 effectiveWriteBurstSize() const;
+
+    qint64 writeRateLimit = 0;
+    qint64 writeBurstSize = 0;
+    std::chrono::microseconds writeInterFrameGap{0};
+    double writeTokens = 0;
+    QElapsedTimer writeTokenTimer;
+    QDeadlineTimer nextWriteFrameDeadline;
+    QList<qint64> writeFrameSizes; // of the frames in the write buffer
+
+    int bitsPerCharacter() const;
+    std::chrono::milliseconds transmitTimeEstimate() const;
+    bool isAllBytesTransmittedConnected() const;
+    void startTransmitPolling();
+    void pollTransmitted();
+    bool waitForTransmitted(QDeadlineTimer deadline);
+
+    QTimer *transmitPollTimer = nullptr;
+
+    std::chrono::microseconds effectiveInterFrameTimeout() const;
+    void checkInterFrameGap();
+    void restartInterFrameTimer();
+    void interFrameTimerExpired();
+    int remainingInterFrameGap() const;
+    void completeFrame();
+
+    void recordReceivedData(qint64 bytes);
+    void dropConsumedTimestamps();
+
+    struct ReceiveTimestamp
+    {
+        std::chrono::steady_clock::time_point time;
+        qint64 position; // of the first byte within all data received
+        qint64 size;
+    };
+
+    qint64 totalBytesReceived = 0;
+    bool receiveTimestampsEnabled = false;
+    QList<ReceiveTimestamp> receiveTimestamps;
+
+    qint64 findLineEnd() const;
+    qint64 findDelimiter(QByteArrayView delimiter, qint64 *scanPosition) const;
+    bool isDelimiterAt(qint64 pos, QByteArrayView delimiter) const;
+
+    bool waitForBytesAvailable(qint64 count, QDeadlineTimer deadline);
+    bool waitForDelimiter(QByteArrayView delimiter, QDeadlineTimer deadline);
+
+    QByteArray lineDelimiter = QByteArray(1, '\n');
+    mutable qint64 lineScanPosition = 0; // within all data received
+    mutable qint64 newlineScanPosition = 0; // for canReadLine()
+
+    bool frameDelimitingEnabled = false;
+    std::chrono::microseconds interFrameTimeout{0};
+    QByteArray frameBuffer;
+    bool frameCompleted = false;
+    QElapsedTimer frameElapsedTimer;
+    QTimer *interFrameTimer = nullptr;
 
     void setBindableError(QSerialPort::SerialPortError error)
     { setError(error); }
@@ -165,12 +296,24 @@ public:
 
     bool settingsRestoredOnClose = true;
 
+    QSerialPort::Rs485Settings rs485Settings;
+    bool rs485SettingsSet = false;
+
     bool setBindableBreakEnabled(bool isBreakEnabled)
     { return q_func()->setBreakEnabled(isBreakEnabled); }
     Q_OBJECT_COMPAT_PROPERTY_WITH_ARGS(QSerialPortPrivate, bool, isBreakEnabled,
         &QSerialPortPrivate::setBindableBreakEnabled, false)
 
     bool startAsyncRead();
+    void emitReadyRead();
+
+    qint64 queuedBytesCount(QSerialPort::Direction direction) const;
+    bool isTransmitComplete() const;
+    void interruptWait();
+    bool sleepInterruptibly(QDeadlineTimer deadline);
+
+    static QList<QSerialPort *> waitForAnyReadyRead(const QList<QSerialPort *> &ports,
+                                                    QDeadlineTimer deadline);
 
 #if defined(Q_OS_WIN32)
 
@@ -178,8 +321,6 @@ public:
     bool getDcb(DCB *dcb);
     OVERLAPPED *waitForNotified(QDeadlineTimer deadline);
 
-    qint64 queuedBytesCount(QSerialPort::Direction direction) const;
-
     bool completeAsyncCommunication(qint64 bytesTransferred);
     bool completeAsyncRead(qint64 bytesTransferred);
     bool completeAsyncWrite(qint64 bytesTransferred);
@@ -188,8 +329,6 @@ public:
     bool _q_startAsyncWrite();
     void _q_notified(DWORD numberOfBytes, DWORD errorCode, OVERLAPPED *overlapped);
 
-    void emitReadyRead();
-
     DCB restoredDcb;
     COMMTIMEOUTS currentCommTimeouts;
     COMMTIMEOUTS restoredCommTimeouts;
@@ -223,24 +362,80 @@ public:
 
     bool waitForReadOrWrite(bool *selectForRead, bool *selectForWrite,
                             bool checkRead, bool checkWrite,
-                            int msecs);
+                            int msecs, bool reportTimeout = true);
+
+    static bool openEventDescriptors(int *readDescriptor, int *writeDescriptor);
+    static void closeEventDescriptors(int *readDescriptor, int *writeDescriptor);
+    static void clearEvent(int readDescriptor);
+    static void signalEvent(int writeDescriptor);
+
+    int readNotificationDescriptor() const;
+    bool createIoThread();
+    void stopIoThread();
+    void resumeIoThread();
+    void runIoThread();
+
+    bool acquireReactor();
+    void releaseReactor();
+    void updateReactor();
 
     qint64 readFromPort(char *data, qint64 maxSize);
     qint64 writeToPort(const char *data, qint64 maxSize);
+    qint64 writeBufferToPort(qint64 maxSize);
 
 #ifndef CMSPAR
     qint64 writePerChar(const char *data, qint64 maxSize);
 #endif
 
     bool readNotification();
+    qint64 readUnbuffered(char *data, qint64 maxSize);
+    void emitHeldBackReadyRead();
+    bool busyPollForRead(int msecs);
+    bool setSenderThrottled(bool throttle);
+    bool isReadingSuspended() const;
     bool startAsyncWrite();
     bool completeAsyncWrite();
+    bool holdBackWrite();
+    void startHeldBackWrite();
+    bool isWritePacingEnabled() const;
+    qint64 pacedWriteSize(qint64 size, bool urgent);
+    void completePacedWrite(qint64 written, bool urgent);
 
     struct termios restoredTermios;
     int descriptor = -1;
+    // The event descriptors are the same eventfd on Linux, a pipe elsewhere.
+    // The wakeup descriptors are only created by the first blocking wait.
+    int wakeupReadDescriptor = -1; // wakes the blocking waits up
+    int wakeupWriteDescriptor = -1;
+    QMutex wakeupMutex; // guards the creation against interruptWait()
+    QAtomicInt waitInterrupted;
+
+    bool startInterruptibleWait();
+    void reportWaitInterrupted();
+
+    std::unique_ptr<QThread> ioThread;
+    std::unique_ptr<QSerialPortReceiveRing> ioThreadRing;
+    int ioThreadDataReadDescriptor = -1; // signaled by the I/O thread on new data
+    int ioThreadDataWriteDescriptor = -1;
+    int ioThreadWakeupReadDescriptor = -1; // signaled to stop or resume the I/O thread
+    int ioThreadWakeupWriteDescriptor = -1;
+    QAtomicInt ioThreadStopRequested;
+    QAtomicInt ioThreadWaitingForRoom;
+    QAtomicInt ioThreadFinished;
+    QAtomicInt ioThreadErrorCode;
+
+    // Replaces the notifiers when the shared reactor is used, Linux only
+    QSerialPortReactor *reactor = nullptr;
+    bool reactorReadEnabled = false;
+    bool reactorWriteEnabled = false;
+    bool reactorRegistered = false;
 
     QSocketNotifier *readNotifier = nullptr;
     QSocketNotifier *writeNotifier = nullptr;
+    QTimer *readyReadDelayTimer = nullptr;
+    bool readyReadHeldBack = false;
+    QTimer *writeCoalescingTimer = nullptr;
+    QTimer *writePacingTimer = nullptr;
 
     bool readPortNotifierCalled = false;
     bool readPortNotifierState = false;
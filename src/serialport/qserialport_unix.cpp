@@ -11,13 +11,20 @@
 #include <QtCore/qmap.h>
 #include <QtCore/qsocketnotifier.h>
 #include <QtCore/qstandardpaths.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qtimer.h>
+#include <QtCore/qvarlengtharray.h>
 
 #include <private/qcore_unix_p.h>
 
+#include <array>
+
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <sys/ioctl.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #ifdef Q_OS_MACOS
@@ -26,6 +33,11 @@
 #endif
 #endif
 
+#ifdef Q_OS_LINUX
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
 #ifdef Q_OS_QNX
 #define CRTSCTS (IHFLOW | OHFLOW)
 #endif
@@ -115,7 +127,7 @@ class ReadNotifier : public QSocketNotifier
 {
 public:
     explicit ReadNotifier(QSerialPortPrivate *d, QObject *parent)
-        : QSocketNotifier(d->descriptor, QSocketNotifier::Read, parent)
+        : QSocketNotifier(d->readNotificationDescriptor(), QSocketNotifier::Read, parent)
         , dptr(d)
     {
     }
@@ -157,6 +169,228 @@ private:
     QSerialPortPrivate * const dptr;
 };
 
+class IoThread : public QThread
+{
+public:
+    explicit IoThread(QSerialPortPrivate *d)
+        : dptr(d)
+    {
+        setObjectName(QStringLiteral("QSerialPort I/O"));
+    }
+
+protected:
+    void run() override
+    {
+        dptr->runIoThread();
+    }
+
+private:
+    QSerialPortPrivate * const dptr;
+};
+
+#ifdef Q_OS_LINUX
+
+// Services the ports of one thread with a single epoll instance, which is
+// watched by one notifier, instead of two notifiers per port. The ready
+// ports are dispatched in batches.
+class QSerialPortReactor : public QObject
+{
+public:
+    static QSerialPortReactor *acquire();
+    void release();
+
+    bool updatePort(QSerialPortPrivate *d);
+    void removePort(QSerialPortPrivate *d);
+
+private:
+    explicit QSerialPortReactor(int epollDescriptor);
+    ~QSerialPortReactor() override;
+
+    void processEvents();
+
+    static constexpr int maxEvents = 64;
+
+    const int epollDescriptor;
+    QSocketNotifier notifier;
+    int refCount = 0;
+    bool deleteAfterDispatch = false;
+
+    // The batch being dispatched, whose events are dropped for removed ports
+    epoll_event *dispatchedEvents = nullptr;
+    int dispatchedCount = 0;
+    int dispatchIndex = 0;
+};
+
+static thread_local QSerialPortReactor *threadReactor = nullptr;
+
+QSerialPortReactor::QSerialPortReactor(int epollDescriptor)
+    : epollDescriptor(epollDescriptor)
+    , notifier(epollDescriptor, QSocketNotifier::Read)
+{
+    connect(&notifier, &QSocketNotifier::activated, this, &QSerialPortReactor::processEvents);
+}
+
+QSerialPortReactor::~QSerialPortReactor()
+{
+    notifier.setEnabled(false);
+    qt_safe_close(epollDescriptor);
+}
+
+QSerialPortReactor *QSerialPortReactor::acquire()
+{
+    if (!threadReactor) {
+        const int epollDescriptor = ::epoll_create1(EPOLL_CLOEXEC);
+        if (epollDescriptor == -1)
+            return nullptr;
+        threadReactor = new QSerialPortReactor(epollDescriptor);
+    }
+
+    ++threadReactor->refCount;
+    return threadReactor;
+}
+
+void QSerialPortReactor::release()
+{
+    if (--refCount > 0)
+        return;
+
+    if (threadReactor == this)
+        threadReactor = nullptr;
+
+    // The last port might be closed by a slot called from processEvents()
+    if (dispatchedEvents)
+        deleteAfterDispatch = true;
+    else
+        delete this;
+}
+
+bool QSerialPortReactor::updatePort(QSerialPortPrivate *d)
+{
+    // A port is only registered while it waits for something, as epoll
+    // reports hangups and errors even without any requested events.
+    const uint32_t events = (d->reactorReadEnabled ? EPOLLIN : 0)
+            | (d->reactorWriteEnabled ? EPOLLOUT : 0);
+    if (events == 0) {
+        removePort(d);
+        return true;
+    }
+
+    epoll_event event = {};
+    event.events = events;
+    event.data.ptr = d;
+    const int operation = d->reactorRegistered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (::epoll_ctl(epollDescriptor, operation, d->descriptor, &event) == -1)
+        return false;
+
+    d->reactorRegistered = true;
+    return true;
+}
+
+void QSerialPortReactor::removePort(QSerialPortPrivate *d)
+{
+    if (d->reactorRegistered) {
+        ::epoll_ctl(epollDescriptor, EPOLL_CTL_DEL, d->descriptor, nullptr);
+        d->reactorRegistered = false;
+    }
+
+    for (int i = dispatchIndex; i < dispatchedCount; ++i) {
+        if (dispatchedEvents[i].data.ptr == d)
+            dispatchedEvents[i].data.ptr = nullptr;
+    }
+}
+
+void QSerialPortReactor::processEvents()
+{
+    epoll_event events[maxEvents];
+    int count = 0;
+    EINTR_LOOP(count, ::epoll_wait(epollDescriptor, events, maxEvents, 0));
+    if (count <= 0)
+        return;
+
+    dispatchedEvents = events;
+    dispatchedCount = count;
+    for (dispatchIndex = 0; dispatchIndex < dispatchedCount; ++dispatchIndex) {
+        epoll_event &event = events[dispatchIndex];
+
+        // Hangups and errors are reported to both sides, like the notifiers do
+        if ((event.events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && event.data.ptr) {
+            auto d = static_cast<QSerialPortPrivate *>(event.data.ptr);
+            if (d->reactorReadEnabled)
+                d->readNotification();
+        }
+        if ((event.events & (EPOLLOUT | EPOLLHUP | EPOLLERR)) && event.data.ptr) {
+            auto d = static_cast<QSerialPortPrivate *>(event.data.ptr);
+            if (d->reactorWriteEnabled)
+                d->completeAsyncWrite();
+        }
+    }
+    dispatchedEvents = nullptr;
+    dispatchedCount = 0;
+    dispatchIndex = 0;
+
+    if (deleteAfterDispatch)
+        delete this;
+}
+
+#endif // Q_OS_LINUX
+
+// The capacity of the ring between the I/O thread and the owner thread
+static constexpr quintptr ioThreadRingSize = 8 * QSERIALPORT_BUFFERSIZE;
+
+QSerialPortReceiveRing::QSerialPortReceiveRing(quintptr capacity)
+    : capacity(capacity)
+    , ring(new char[capacity])
+{
+    Q_ASSERT((capacity & (capacity - 1)) == 0);
+}
+
+quintptr QSerialPortReceiveRing::size() const
+{
+    // Load the tail first, so that the size never exceeds the capacity.
+    const quintptr currentTail = tail.loadAcquire();
+    return head.loadAcquire() - currentTail;
+}
+
+qint64 QSerialPortReceiveRing::readFromDescriptor(int descriptor)
+{
+    const quintptr currentHead = head.loadRelaxed();
+    const quintptr freeSize = capacity - (currentHead - tail.loadAcquire());
+    if (freeSize == 0)
+        return 0;
+
+    const quintptr offset = currentHead & (capacity - 1);
+    const quintptr firstSize = qMin(freeSize, capacity - offset);
+    iovec iov[2] = {
+        { ring.get() + offset, firstSize },
+        { ring.get(), freeSize - firstSize }
+    };
+
+    qint64 readBytes = 0;
+    EINTR_LOOP(readBytes, ::readv(descriptor, iov, freeSize > firstSize ? 2 : 1));
+    if (readBytes > 0)
+        head.storeRelease(currentHead + quintptr(readBytes));
+    return readBytes;
+}
+
+qint64 QSerialPortReceiveRing::read(char *data, qint64 maxSize)
+{
+    const quintptr currentTail = tail.loadRelaxed();
+    const quintptr readBytes = qMin(quintptr(maxSize), head.loadAcquire() - currentTail);
+
+    const quintptr offset = currentTail & (capacity - 1);
+    const quintptr firstSize = qMin(readBytes, capacity - offset);
+    std::memcpy(data, ring.get() + offset, firstSize);
+    std::memcpy(data + firstSize, ring.get(), readBytes - firstSize);
+
+    tail.storeRelease(currentTail + readBytes);
+    return qint64(readBytes);
+}
+
+void QSerialPortReceiveRing::clear()
+{
+    tail.storeRelease(head.loadAcquire());
+}
+
 static inline void qt_set_common_props(termios *tio, QIODevice::OpenMode m)
 {
 #ifdef Q_OS_SOLARIS
@@ -309,11 +543,36 @@ bool QSerialPortPrivate::open(QIODevice::OpenMode mode)
         return false;
     }
 
+    // The I/O thread is prepared before the read notifier is created
+    // in initialize(), and started once the port is set up. The timestamps
+    // and the frame delimiting need the time the data is read, so they
+    // keep the reading in the owner thread.
+    const bool useIoThread = ioThreadEnabled && (mode & QIODevice::ReadOnly)
+            && !(mode & QIODevice::Unbuffered)
+            && !receiveTimestampsEnabled && !frameDelimitingEnabled;
+    if (useIoThread && !createIoThread()) {
+        setError(getSystemError());
+        qt_safe_close(descriptor);
+        return false;
+    }
+
+    // The reactor watches the port itself, so the I/O thread keeps its notifier
+    if (sharedReactorEnabled && !ioThread && !acquireReactor()) {
+        setError(getSystemError());
+        qt_safe_close(descriptor);
+        return false;
+    }
+
     if (!initialize(mode)) {
+        releaseReactor();
+        stopIoThread();
         qt_safe_close(descriptor);
         return false;
     }
 
+    if (ioThread)
+        ioThread->start(QThread::HighestPriority);
+
     lockFileScopedPointer = std::move(newLockFileScopedPointer);
 
     return true;
@@ -334,7 +593,26 @@ void QSerialPortPrivate::close()
     delete writeNotifier;
     writeNotifier = nullptr;
 
+    releaseReactor();
+
+    delete readyReadDelayTimer;
+    readyReadDelayTimer = nullptr;
+    readyReadHeldBack = false;
+
+    delete writeCoalescingTimer;
+    writeCoalescingTimer = nullptr;
+
+    delete writePacingTimer;
+    writePacingTimer = nullptr;
+
+    stopIoThread();
+
     qt_safe_close(descriptor);
+    {
+        const QMutexLocker locker(&wakeupMutex);
+        closeEventDescriptors(&wakeupReadDescriptor, &wakeupWriteDescriptor);
+    }
+    waitInterrupted.storeRelaxed(0);
 
     lockFileScopedPointer.reset(nullptr);
 
@@ -422,6 +700,50 @@ bool QSerialPortPrivate::setRequestToSend(bool set)
     return true;
 }
 
+bool QSerialPortPrivate::setRs485Settings(const QSerialPort::Rs485Settings &settings)
+{
+#if defined(TIOCSRS485) && defined(SER_RS485_ENABLED)
+    // Keep the flags which are not covered by the settings, like the
+    // bus termination some drivers support.
+    struct serial_rs485 rs485;
+    if (::ioctl(descriptor, TIOCGRS485, &rs485) == -1)
+        ::memset(&rs485, 0, sizeof(rs485));
+
+    rs485.flags &= ~(SER_RS485_ENABLED | SER_RS485_RTS_ON_SEND
+                     | SER_RS485_RTS_AFTER_SEND | SER_RS485_RX_DURING_TX);
+    if (settings.isEnabled())
+        rs485.flags |= SER_RS485_ENABLED;
+    if (settings.rtsOnSend())
+        rs485.flags |= SER_RS485_RTS_ON_SEND;
+    if (settings.rtsAfterSend())
+        rs485.flags |= SER_RS485_RTS_AFTER_SEND;
+    if (settings.receiveDuringTransmit())
+        rs485.flags |= SER_RS485_RX_DURING_TX;
+    rs485.delay_rts_before_send = quint32(qMax(qint64(settings.delayBeforeSend().count()), qint64(0)));
+    rs485.delay_rts_after_send = quint32(qMax(qint64(settings.delayAfterSend().count()), qint64(0)));
+
+    if (::ioctl(descriptor, TIOCSRS485, &rs485) == -1) {
+        setError(getSystemError());
+        return false;
+    }
+
+    // The driver returns the configuration it applied, with
+    // the delays limited to what the hardware supports.
+    rs485Settings.setEnabled(rs485.flags & SER_RS485_ENABLED);
+    rs485Settings.setRtsOnSend(rs485.flags & SER_RS485_RTS_ON_SEND);
+    rs485Settings.setRtsAfterSend(rs485.flags & SER_RS485_RTS_AFTER_SEND);
+    rs485Settings.setReceiveDuringTransmit(rs485.flags & SER_RS485_RX_DURING_TX);
+    rs485Settings.setDelayBeforeSend(std::chrono::milliseconds(rs485.delay_rts_before_send));
+    rs485Settings.setDelayAfterSend(std::chrono::milliseconds(rs485.delay_rts_after_send));
+    return true;
+#else
+    Q_UNUSED(settings);
+    setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                                  QSerialPort::tr("RS-485 mode is not supported")));
+    return false;
+#endif
+}
+
 bool QSerialPortPrivate::flush()
 {
     return completeAsyncWrite();
@@ -435,6 +757,11 @@ bool QSerialPortPrivate::clear(QSerialPort::Directions directions)
         return false;
     }
 
+    if (ioThreadRing && (directions & QSerialPort::Input)) {
+        ioThreadRing->clear();
+        resumeIoThread();
+    }
+
     return true;
 }
 
@@ -463,45 +790,142 @@ bool QSerialPortPrivate::waitForReadyRead(int msecs)
     QElapsedTimer stopWatch;
     stopWatch.start();
 
+    // In the frame delimiting mode, the data is not added to the read
+    // buffer, so wait until a frame is complete instead.
+    frameCompleted = false;
+
+    // The application might have consumed enough data to resume the sender
+    updateReadThrottling();
+
+    // A stale notification of the I/O thread, or data the I/O thread has
+    // not taken from the driver yet, reads nothing. The wait goes on then.
+    const auto hasReceivedSince = [this](qint64 receivedBytes) {
+        return totalBytesReceived != receivedBytes || (openMode & QIODevice::Unbuffered);
+    };
+
+    if (busyPollDuration.count() > 0 && !isReadingSuspended() && busyPollForRead(msecs)) {
+        const qint64 receivedBytes = totalBytesReceived;
+        if (!readNotification())
+            return false;
+        if (!frameDelimitingEnabled && hasReceivedSince(receivedBytes)) {
+            emitHeldBackReadyRead();
+            return true;
+        }
+    }
+
     do {
+        if (frameCompleted)
+            return true;
+
+        // A pending frame completes when the line stays idle long enough
+        int timeout = qt_subtract_from_timeout(msecs, stopWatch.elapsed());
+        const int gapTimeout = frameDelimitingEnabled ? remainingInterFrameGap() : -1;
+        const bool waitForGap = gapTimeout >= 0 && (timeout < 0 || gapTimeout < timeout);
+        if (waitForGap)
+            timeout = gapTimeout;
+
         bool readyToRead = false;
         bool readyToWrite = false;
-        if (!waitForReadOrWrite(&readyToRead, &readyToWrite, true, !writeBuffer.isEmpty(),
-                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
+        const bool checkRead = !isReadingSuspended();
+        const bool checkWrite = !writeBuffer.isEmpty() || !urgentWriteBuffer.isEmpty();
+        if (!waitForReadOrWrite(&readyToRead, &readyToWrite, checkRead, checkWrite,
+                                timeout, !waitForGap)) {
             return false;
         }
 
-        if (readyToRead)
-            return readNotification();
+        if (readyToRead) {
+            const qint64 receivedBytes = totalBytesReceived;
+            if (!readNotification())
+                return false;
+            if (!frameDelimitingEnabled && hasReceivedSince(receivedBytes)) {
+                // the blocking call does not wait for the readyRead() threshold
+                emitHeldBackReadyRead();
+                return true;
+            }
+        } else if (waitForGap && !readyToWrite) {
+            checkInterFrameGap();
+        }
 
         if (readyToWrite && !completeAsyncWrite())
             return false;
-    } while (msecs == -1 || qt_subtract_from_timeout(msecs, stopWatch.elapsed()) > 0);
+    } while (frameCompleted || msecs == -1
+             || qt_subtract_from_timeout(msecs, stopWatch.elapsed()) > 0);
+    return false;
+}
+
+bool QSerialPortPrivate::busyPollForRead(int msecs)
+{
+    // Ask the driver for the queued bytes instead of reading, as a
+    // read of the empty queue is reported as an error by readNotification().
+    qint64 spinNsecs = std::chrono::nanoseconds(busyPollDuration).count();
+    if (msecs >= 0)
+        spinNsecs = qMin(spinNsecs, qint64(msecs) * 1000000);
+
+    QElapsedTimer spinTimer;
+    spinTimer.start();
+    do {
+        if (queuedBytesCount(QSerialPort::Input) > 0) {
+            ++busyPollHits;
+            return true;
+        }
+        // The blocking wait which follows reports the interruption
+        if (waitInterrupted.loadRelaxed())
+            return false;
+    } while (spinTimer.nsecsElapsed() < spinNsecs);
+
+    ++busyPollFallbacks;
     return false;
 }
 
 bool QSerialPortPrivate::waitForBytesWritten(int msecs)
 {
-    if (writeBuffer.isEmpty() && pendingBytesWritten <= 0)
+    if (writeBuffer.isEmpty() && urgentWriteBuffer.isEmpty() && pendingBytesWritten <= 0)
         return false;
 
     QElapsedTimer stopWatch;
     stopWatch.start();
 
     for (;;) {
+        const int timeout = qt_subtract_from_timeout(msecs, stopWatch.elapsed());
+
+        // The paced data waits for the pacing timer, which the blocking
+        // call does not process, so sleep until the data is due.
+        if (!writeSequenceStarted && writePacingTimer && writePacingTimer->isActive()) {
+            const QDeadlineTimer deadline(timeout);
+            const QDeadlineTimer pacingDeadline(writePacingTimer->remainingTime(), Qt::PreciseTimer);
+            if (deadline < pacingDeadline) {
+                if (sleepInterruptibly(deadline))
+                    setError(QSerialPortErrorInfo(QSerialPort::TimeoutError));
+                return false;
+            }
+            if (!sleepInterruptibly(pacingDeadline))
+                return false;
+            writePacingTimer->stop();
+            if (!startAsyncWrite())
+                return false;
+            continue;
+        }
+
         bool readyToRead = false;
         bool readyToWrite = false;
-        const bool checkRead = q_func()->isReadable();
-        if (!waitForReadOrWrite(&readyToRead, &readyToWrite, checkRead, !writeBuffer.isEmpty(),
-                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
+        const bool checkRead = q_func()->isReadable() && !isReadingSuspended();
+        const bool checkWrite = !writeBuffer.isEmpty() || !urgentWriteBuffer.isEmpty()
+                || writeSequenceStarted;
+        if (!waitForReadOrWrite(&readyToRead, &readyToWrite, checkRead, checkWrite, timeout))
             return false;
-        }
 
         if (readyToRead && !readNotification())
             return false;
 
-        if (readyToWrite)
-            return completeAsyncWrite();
+        if (readyToWrite) {
+            // Only report success once some data has been written, the
+            // pacing might have held back all of it.
+            const bool hasWritten = pendingBytesWritten > 0;
+            if (!completeAsyncWrite())
+                return false;
+            if (hasWritten)
+                return true;
+        }
     }
     return false;
 }
@@ -725,65 +1149,286 @@ bool QSerialPortPrivate::setFlowControl(QSerialPort::FlowControl flowControl)
 bool QSerialPortPrivate::startAsyncRead()
 {
     setReadNotificationEnabled(true);
+
+    // The data left in the ring when the read buffer got full
+    // has no pending notification any more.
+    if (ioThreadRing && ioThreadRing->size() > 0)
+        signalEvent(ioThreadDataWriteDescriptor);
     return true;
 }
 
 bool QSerialPortPrivate::readNotification()
 {
-    Q_Q(QSerialPort);
+    if ((openMode & QIODevice::Unbuffered) && !frameDelimitingEnabled) {
+        // The data stays in the driver until the user reads it, so
+        // suspend the notifications until then.
+        setReadNotificationEnabled(false);
+        emitReadyRead();
+        return true;
+    }
+
+    if (isReadingSuspended()) {
+        // Nothing is read while the data is left in the driver
+        setReadNotificationEnabled(false);
+        return true;
+    }
+
+    if (ioThreadRing) {
+        // Clear the notification before looking at the ring, so that
+        // the data the I/O thread adds meanwhile is notified again.
+        clearEvent(ioThreadDataReadDescriptor);
+        if (ioThreadRing->size() == 0 && !ioThreadFinished.loadAcquire())
+            return true;
+    }
 
-    // Always buffered, read data from the port into the read buffer
+    // Read data from the port into the read buffer, or into
+    // the pending frame in the frame delimiting mode
     qint64 newBytes = buffer.size();
-    qint64 bytesToRead = QSERIALPORT_BUFFERSIZE;
 
-    if (readBufferMaxSize && bytesToRead > (readBufferMaxSize - buffer.size())) {
-        bytesToRead = readBufferMaxSize - buffer.size();
-        if (bytesToRead <= 0) {
-            // Buffer is full. User must read data from the buffer
-            // before we can read more from the port.
-            setReadNotificationEnabled(false);
+    if (frameDelimitingEnabled)
+        checkInterFrameGap();
+
+    const bool drainEnabled = readDrainMaxBytes > 0 || readDrainMaxDuration.count() > 0;
+    QElapsedTimer drainTimer;
+    if (readDrainMaxDuration.count() > 0)
+        drainTimer.start();
+    qint64 drainedBytes = 0;
+
+    for (;;) {
+        qint64 bytesToRead = QSERIALPORT_BUFFERSIZE;
+
+        if (readChunkPolicy == QSerialPort::AdaptiveReadChunk) {
+            // Reserve only what the driver has queued, because reserving a whole
+            // chunk for a small read forces the read buffer to allocate a new one.
+            const qint64 queuedBytes = queuedBytesCount(QSerialPort::Input);
+            if (queuedBytes == 0 && drainedBytes > 0)
+                break;
+            if (queuedBytes >= 0)
+                bytesToRead = qBound(qint64(1), queuedBytes, bytesToRead);
+        }
+
+        if (!frameDelimitingEnabled && readBufferMaxSize
+                && bytesToRead > (readBufferMaxSize - buffer.size())) {
+            bytesToRead = readBufferMaxSize - buffer.size();
+            if (bytesToRead <= 0) {
+                // Buffer is full. User must read data from the buffer
+                // before we can read more from the port.
+                setReadNotificationEnabled(false);
+                if (drainedBytes == 0)
+                    return false;
+                break;
+            }
+        }
+
+        if (readDrainMaxBytes > 0)
+            bytesToRead = qMin(bytesToRead, readDrainMaxBytes - drainedBytes);
+
+        char *ptr = nullptr;
+        if (frameDelimitingEnabled) {
+            const qsizetype frameSize = frameBuffer.size();
+            frameBuffer.resize(frameSize + bytesToRead);
+            ptr = frameBuffer.data() + frameSize;
+        } else {
+            ptr = buffer.reserve(bytesToRead);
+        }
+
+        const qint64 readBytes = readFromPort(ptr, bytesToRead);
+
+        const qint64 unusedBytes = bytesToRead - qMax(readBytes, qint64(0));
+        if (frameDelimitingEnabled)
+            frameBuffer.chop(unusedBytes);
+        else
+            buffer.chop(unusedBytes);
+
+        if (readBytes < 0) {
+            // The driver queue is drained, this is not an error
+            if (drainedBytes > 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                break;
+
+            QSerialPortErrorInfo error = getSystemError();
+            if (error.errorCode != QSerialPort::ResourceError)
+                error.errorCode = QSerialPort::ReadError;
+            else
+                setReadNotificationEnabled(false);
+            setError(error);
             return false;
+        } else if (readBytes == 0) {
+            if (drainedBytes == 0)
+                return false;
+            break;
+        }
+
+        drainedBytes += readBytes;
+        if (!frameDelimitingEnabled)
+            recordReceivedData(readBytes);
+
+        // Keep reading until the driver queue is drained or the budget is spent,
+        // so that a burst of data results in one readyRead() emission only.
+        if (!drainEnabled
+                || (readDrainMaxBytes > 0 && drainedBytes >= readDrainMaxBytes)
+                || (drainTimer.isValid()
+                    && drainTimer.nsecsElapsed() >= std::chrono::nanoseconds(readDrainMaxDuration).count())) {
+            break;
         }
     }
 
-    char *ptr = buffer.reserve(bytesToRead);
-    const qint64 readBytes = readFromPort(ptr, bytesToRead);
+    // Come back for the rest of the ring, which was not drained at once
+    if (ioThreadRing && ioThreadRing->size() > 0)
+        signalEvent(ioThreadDataWriteDescriptor);
 
-    buffer.chop(bytesToRead - qMax(readBytes, qint64(0)));
+    if (frameDelimitingEnabled) {
+        if (readBufferMaxSize && frameBuffer.size() >= readBufferMaxSize)
+            completeFrame();
+        else
+            restartInterFrameTimer();
+        return true;
+    }
 
+    newBytes = buffer.size() - newBytes;
+
+    updateReadThrottling();
+
+    // only emit readyRead() if there is data available
+    const bool hasData = newBytes > 0;
+    if (!hasData)
+        return true;
+
+    qint64 threshold = readyReadThreshold;
+    if (readBufferMaxSize)
+        threshold = qMin(threshold, readBufferMaxSize);
+
+    if (buffer.size() < threshold) {
+        // Hold back readyRead() until enough data is buffered or the delay expires
+        readyReadHeldBack = true;
+        if (readyReadMaxDelay.count() > 0) {
+            ensurePreciseTimer(readyReadDelayTimer, &QSerialPortPrivate::emitHeldBackReadyRead);
+            if (!readyReadDelayTimer->isActive())
+                readyReadDelayTimer->start(readyReadMaxDelay);
+        }
+        return true;
+    }
+
+    readyReadHeldBack = false;
+    if (readyReadDelayTimer)
+        readyReadDelayTimer->stop();
+
+    emitReadyRead();
+    return true;
+}
+
+qint64 QSerialPortPrivate::readUnbuffered(char *data, qint64 maxSize)
+{
+    // Re-enable the notifications, which were suspended by
+    // readNotification() until the user reads the data.
+    startAsyncRead();
+
+    if (maxSize <= 0)
+        return 0;
+
+    const qint64 readBytes = readFromPort(data, maxSize);
     if (readBytes < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return 0;
+
         QSerialPortErrorInfo error = getSystemError();
         if (error.errorCode != QSerialPort::ResourceError)
             error.errorCode = QSerialPort::ReadError;
         else
             setReadNotificationEnabled(false);
         setError(error);
-        return false;
-    } else if (readBytes == 0) {
-        return false;
+        return -1;
     }
 
-    newBytes = buffer.size() - newBytes;
+    recordReceivedData(readBytes);
+    return readBytes;
+}
 
-    // only emit readyRead() when not recursing, and only if there is data available
-    const bool hasData = newBytes > 0;
+void QSerialPortPrivate::emitReadyRead()
+{
+    Q_Q(QSerialPort);
 
-    if (!emittedReadyRead && hasData) {
+    // only emit readyRead() when not recursing
+    if (!emittedReadyRead) {
         emittedReadyRead = true;
         emit q->readyRead();
         emittedReadyRead = false;
+
+        // The handlers might have read a part of the buffer
+        updateReadThrottling();
+    }
+}
+
+void QSerialPortPrivate::emitHeldBackReadyRead()
+{
+    // The held back state is tracked apart from the timer, which
+    // is not started when the readyRead() delay is not limited.
+    if (!readyReadHeldBack)
+        return;
+
+    readyReadHeldBack = false;
+    if (readyReadDelayTimer)
+        readyReadDelayTimer->stop();
+    emitReadyRead();
+}
+
+bool QSerialPortPrivate::setSenderThrottled(bool throttle)
+{
+    switch (flowControl) {
+    case QSerialPort::HardwareControl:
+        // Clearing RTS by hand would fight the driver, which controls it with
+        // CRTSCTS. Leave the data in the driver instead, which clears RTS
+        // once its queue fills up.
+        if (throttle)
+            setReadNotificationEnabled(false);
+        else
+            startAsyncRead();
+        break;
+    case QSerialPort::SoftwareControl:
+        if (::tcflow(descriptor, throttle ? TCIOFF : TCION) == -1) {
+            setError(getSystemError());
+            return false;
+        }
+        break;
+    default:
+        break;
     }
 
     return true;
 }
 
+bool QSerialPortPrivate::isReadingSuspended() const
+{
+    // The sender is throttled by leaving the data in the driver
+    return readThrottled && flowControl.value() == QSerialPort::HardwareControl
+            && !senderThrottlingFailed;
+}
+
 bool QSerialPortPrivate::startAsyncWrite()
 {
-    if (writeBuffer.isEmpty() || writeSequenceStarted)
+    if ((writeBuffer.isEmpty() && urgentWriteBuffer.isEmpty()) || writeSequenceStarted)
+        return true;
+
+    if (writeCoalescingTimer)
+        writeCoalescingTimer->stop();
+
+    // The urgent data goes out before the rest of the write buffer.
+    const bool urgent = !urgentWriteBuffer.isEmpty();
+    qint64 bytesToWrite = urgent ? urgentWriteBuffer.nextDataBlockSize() : writeBuffer.size();
+
+    // Limit the amount of data to the current frame and to the rate
+    if (!urgent && writeInterFrameGap.count() > 0 && !writeFrameSizes.isEmpty())
+        bytesToWrite = qMin(bytesToWrite, writeFrameSizes.constFirst());
+    bytesToWrite = pacedWriteSize(bytesToWrite, urgent);
+    if (bytesToWrite == 0) {
+        // Wait for the pacing timer without busy polling the descriptor
+        setWriteNotificationEnabled(false);
         return true;
+    }
 
-    // Attempt to write it all in one chunk.
-    qint64 written = writeToPort(writeBuffer.readPointer(), writeBuffer.nextDataBlockSize());
+    // Attempt to write it all in one system call.
+    qint64 written = urgent
+            ? writeToPort(urgentWriteBuffer.readPointer(), bytesToWrite)
+            : writeBufferToPort(bytesToWrite);
     if (written < 0) {
         QSerialPortErrorInfo error = getSystemError();
         if (error.errorCode != QSerialPort::ResourceError)
@@ -792,8 +1437,12 @@ bool QSerialPortPrivate::startAsyncWrite()
         return false;
     }
 
-    writeBuffer.free(written);
+    if (urgent)
+        urgentWriteBuffer.free(written);
+    else
+        writeBuffer.free(written);
     pendingBytesWritten += written;
+    completePacedWrite(written, urgent);
     writeSequenceStarted = true;
 
     if (!isWriteNotificationEnabled())
@@ -805,6 +1454,7 @@ bool QSerialPortPrivate::completeAsyncWrite()
 {
     Q_Q(QSerialPort);
 
+    const bool hasWritten = pendingBytesWritten > 0;
     if (pendingBytesWritten > 0) {
         if (!emittedBytesWritten) {
             emittedBytesWritten = true;
@@ -816,14 +1466,114 @@ bool QSerialPortPrivate::completeAsyncWrite()
 
     writeSequenceStarted = false;
 
-    if (writeBuffer.isEmpty()) {
+    if (writeBuffer.isEmpty() && urgentWriteBuffer.isEmpty()) {
         setWriteNotificationEnabled(false);
+        if (hasWritten)
+            startTransmitPolling();
         return true;
     }
 
     return startAsyncWrite();
 }
 
+bool QSerialPortPrivate::holdBackWrite()
+{
+    if (writeCoalescingMaxBytes <= 0 || writeBuffer.size() >= writeCoalescingMaxBytes) {
+        if (writeCoalescingTimer)
+            writeCoalescingTimer->stop();
+        return false;
+    }
+
+    // Wait for more data until the delay expires
+    ensurePreciseTimer(writeCoalescingTimer, &QSerialPortPrivate::startHeldBackWrite);
+    if (!writeCoalescingTimer->isActive())
+        writeCoalescingTimer->start(writeCoalescingMaxDelay);
+    return true;
+}
+
+void QSerialPortPrivate::startHeldBackWrite()
+{
+    if ((!writeBuffer.isEmpty() || !urgentWriteBuffer.isEmpty()) && !isWriteNotificationEnabled())
+        setWriteNotificationEnabled(true);
+}
+
+bool QSerialPortPrivate::isWritePacingEnabled() const
+{
+    return writeRateLimit > 0 || writeInterFrameGap.count() > 0;
+}
+
+qint64 QSerialPortPrivate::pacedWriteSize(qint64 size, bool urgent)
+{
+    using namespace std::chrono;
+
+    nanoseconds delay(0);
+
+    // The inter-frame gap only separates frames of normal priority
+    if (!urgent && writeInterFrameGap.count() > 0 && !nextWriteFrameDeadline.hasExpired())
+        delay = nextWriteFrameDeadline.remainingTimeAsDuration();
+
+    if (writeRateLimit > 0) {
+        const qint64 burstSize = effectiveWriteBurstSize();
+        if (writeTokenTimer.isValid()) {
+            const double elapsed = double(writeTokenTimer.nsecsElapsed()) / 1e9;
+            writeTokens = qMin(writeTokens + elapsed * writeRateLimit, double(burstSize));
+        } else {
+            writeTokens = double(burstSize);
+        }
+        writeTokenTimer.start();
+
+        // Wait until a full burst, or the whole data if smaller, can be written
+        const qint64 neededTokens = qMin(size, burstSize);
+        if (writeTokens < neededTokens) {
+            const double seconds = (neededTokens - writeTokens) / writeRateLimit;
+            delay = qMax(delay, ceil<nanoseconds>(duration<double>(seconds)));
+        } else {
+            size = qMin(size, qint64(writeTokens));
+        }
+    }
+
+    if (delay.count() <= 0)
+        return size;
+
+    ensurePreciseTimer(writePacingTimer, &QSerialPortPrivate::startHeldBackWrite)
+            ->start(ceil<milliseconds>(delay));
+    return 0;
+}
+
+void QSerialPortPrivate::completePacedWrite(qint64 written, bool urgent)
+{
+    using namespace std::chrono;
+
+    if (writeRateLimit > 0)
+        writeTokens -= written;
+
+    if (urgent || writeInterFrameGap.count() <= 0 || writeFrameSizes.isEmpty())
+        return;
+
+    qint64 &frameSize = writeFrameSizes.first();
+    frameSize -= written;
+    if (frameSize > 0)
+        return;
+    writeFrameSizes.removeFirst();
+
+    // The gap starts once the driver has transmitted the frame
+    const qint64 queuedBytes = qMax(queuedBytesCount(QSerialPort::Output), qint64(0));
+    const microseconds transmitTime((queuedBytes * bitsPerCharacter() * 1000000) / outputBaudRate);
+    nextWriteFrameDeadline = QDeadlineTimer(transmitTime + writeInterFrameGap, Qt::PreciseTimer);
+}
+
+qint64 QSerialPortPrivate::writeUrgentData(const char *data, qint64 maxSize)
+{
+    urgentWriteBuffer.append(data, maxSize);
+
+    // The urgent data is never held back
+    if (writeCoalescingTimer)
+        writeCoalescingTimer->stop();
+    if (!urgentWriteBuffer.isEmpty() && !isWriteNotificationEnabled())
+        setWriteNotificationEnabled(true);
+    return maxSize;
+}
+
 inline bool QSerialPortPrivate::initialize(QIODevice::OpenMode mode)
 {
 #ifdef TIOCEXCL
@@ -849,6 +1599,9 @@ inline bool QSerialPortPrivate::initialize(QIODevice::OpenMode mode)
     if (!setBaudRate())
         return false;
 
+    if (rs485SettingsSet && !setRs485Settings(rs485Settings))
+        return false;
+
     if (mode & QIODevice::ReadOnly)
         setReadNotificationEnabled(true);
 
@@ -860,9 +1613,45 @@ inline bool QSerialPortPrivate::initialize(QIODevice::OpenMode mode)
 
 qint64 QSerialPortPrivate::writeData(const char *data, qint64 maxSize)
 {
-    writeBuffer.append(data, maxSize);
-    if (!writeBuffer.isEmpty() && !isWriteNotificationEnabled())
+    qint64 written = 0;
+
+    // In the unbuffered or immediate write mode, try to bypass
+    // the write buffer while nothing is queued
+    if (((openMode & QIODevice::Unbuffered) || immediateWriteEnabled)
+            && writeBuffer.isEmpty() && urgentWriteBuffer.isEmpty() && !writeSequenceStarted
+            && !isWritePacingEnabled()) {
+        written = writeToPort(data, maxSize);
+        if (written < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                QSerialPortErrorInfo error = getSystemError();
+                if (error.errorCode != QSerialPort::ResourceError)
+                    error.errorCode = QSerialPort::WriteError;
+                setError(error);
+                return -1;
+            }
+            written = 0;
+        } else if (written > 0) {
+            pendingBytesWritten += written;
+            writeSequenceStarted = true;
+        }
+    }
+
+    if (written == 0) {
+        // Shares the payload passed to QIODevice::write(const QByteArray &)
+        QIODevicePrivate::write(data, maxSize);
+    } else if (written < maxSize) {
+        writeBuffer.append(data + written, maxSize - written);
+    }
+
+    // Each write is a frame of its own for the inter-frame gap
+    if (writeInterFrameGap.count() > 0 && maxSize > 0)
+        writeFrameSizes.append(maxSize);
+    if (writeSequenceStarted) {
+        if (!isWriteNotificationEnabled())
+            setWriteNotificationEnabled(true);
+    } else if (!writeBuffer.isEmpty() && !isWriteNotificationEnabled() && !holdBackWrite()) {
         setWriteNotificationEnabled(true);
+    }
     return maxSize;
 }
 
@@ -951,6 +1740,8 @@ QSerialPortErrorInfo QSerialPortPrivate::getSystemError(int systemErrorCode) con
 
 bool QSerialPortPrivate::isReadNotificationEnabled() const
 {
+    if (reactor)
+        return reactorReadEnabled;
     return readNotifier && readNotifier->isEnabled();
 }
 
@@ -958,6 +1749,14 @@ void QSerialPortPrivate::setReadNotificationEnabled(bool enable)
 {
     Q_Q(QSerialPort);
 
+    if (reactor) {
+        if (reactorReadEnabled != enable) {
+            reactorReadEnabled = enable;
+            updateReactor();
+        }
+        return;
+    }
+
     if (readNotifier) {
         readNotifier->setEnabled(enable);
     } else if (enable) {
@@ -968,6 +1767,8 @@ void QSerialPortPrivate::setReadNotificationEnabled(bool enable)
 
 bool QSerialPortPrivate::isWriteNotificationEnabled() const
 {
+    if (reactor)
+        return reactorWriteEnabled;
     return writeNotifier && writeNotifier->isEnabled();
 }
 
@@ -975,6 +1776,14 @@ void QSerialPortPrivate::setWriteNotificationEnabled(bool enable)
 {
     Q_Q(QSerialPort);
 
+    if (reactor) {
+        if (reactorWriteEnabled != enable) {
+            reactorWriteEnabled = enable;
+            updateReactor();
+        }
+        return;
+    }
+
     if (writeNotifier) {
         writeNotifier->setEnabled(enable);
     } else if (enable) {
@@ -985,41 +1794,452 @@ void QSerialPortPrivate::setWriteNotificationEnabled(bool enable)
 
 bool QSerialPortPrivate::waitForReadOrWrite(bool *selectForRead, bool *selectForWrite,
                                            bool checkRead, bool checkWrite,
-                                           int msecs)
+                                           int msecs, bool reportTimeout)
 {
     Q_ASSERT(selectForRead);
     Q_ASSERT(selectForWrite);
 
-    pollfd pfd = qt_make_pollfd(descriptor, 0);
+    if (!startInterruptibleWait())
+        return false;
+
+    // The received data comes from the I/O thread if there is one.
+    // Unused entries have a negative descriptor and are ignored.
+    pollfd pfds[3] = {
+        qt_make_pollfd(descriptor, 0),
+        qt_make_pollfd(wakeupReadDescriptor, POLLIN),
+        qt_make_pollfd(ioThreadDataReadDescriptor, checkRead ? POLLIN : 0)
+    };
+    pollfd &pfd = pfds[0];
 
-    if (checkRead)
+    if (checkRead && !ioThreadRing)
         pfd.events |= POLLIN;
 
     if (checkWrite)
         pfd.events |= POLLOUT;
 
-    const int ret = qt_safe_poll(&pfd, 1, QDeadlineTimer(msecs));
+    if (pfd.events == 0)
+        pfd.fd = -1;
+
+    const int ret = qt_safe_poll(pfds, 3, QDeadlineTimer(msecs));
     if (ret < 0) {
         setError(getSystemError());
         return false;
     }
     if (ret == 0) {
+        // Without reporting, a timeout returns with neither flag set
+        if (!reportTimeout)
+            return true;
         setError(QSerialPortErrorInfo(QSerialPort::TimeoutError));
         return false;
     }
+    if (pfds[1].revents & POLLIN) {
+        reportWaitInterrupted();
+        return false;
+    }
     if (pfd.revents & POLLNVAL) {
         setError(getSystemError(EBADF));
         return false;
     }
 
     *selectForWrite = ((pfd.revents & POLLOUT) != 0);
-    *selectForRead = ((pfd.revents & POLLIN) != 0);
+    *selectForRead = ((pfd.revents & POLLIN) != 0) || ((pfds[2].revents & POLLIN) != 0);
+    return true;
+}
+
+QList<QSerialPort *> QSerialPortPrivate::waitForAnyReadyRead(const QList<QSerialPort *> &ports,
+                                                             QDeadlineTimer deadline)
+{
+    QList<QSerialPort *> readyPorts;
+    QVarLengthArray<QSerialPortPrivate *, 32> privates;
+    QVarLengthArray<bool, 32> failed;
+
+    const auto hasPendingWrite = [](const QSerialPortPrivate *d) {
+        return !d->writeBuffer.isEmpty() || !d->urgentWriteBuffer.isEmpty() || d->writeSequenceStarted;
+    };
+
+    // The ports which are not readable are only polled for their pending writes
+    for (QSerialPort *port : ports) {
+        if (!port || (!port->isReadable() && !hasPendingWrite(port->d_func())))
+            continue;
+        privates.append(port->d_func());
+        failed.append(false);
+    }
+
+    for (QSerialPortPrivate *d : privates) {
+        // The application might have consumed enough data to resume the sender
+        d->updateReadThrottling();
+        if (!d->startInterruptibleWait())
+            return readyPorts;
+    }
+
+    // Each port has three entries: the port itself, the data notification
+    // of its I/O thread if there is one, and the wakeup of interruptWait().
+    // Unused entries have a negative descriptor and are ignored by poll().
+    QVarLengthArray<pollfd, 96> pfds(3 * privates.size());
+    const auto updateEvents = [&](qsizetype i) {
+        const QSerialPortPrivate *d = privates.at(i);
+        const bool readable = d->q_func()->isReadable() && !d->isReadingSuspended();
+        pollfd &portPfd = pfds[3 * i];
+        pollfd &dataPfd = pfds[3 * i + 1];
+        pfds[3 * i + 2] = qt_make_pollfd(d->wakeupReadDescriptor, POLLIN);
+        portPfd.events = 0;
+        if (readable && !d->ioThreadRing)
+            portPfd.events |= POLLIN;
+        if (hasPendingWrite(d))
+            portPfd.events |= POLLOUT;
+        portPfd.fd = !failed.at(i) && portPfd.events ? d->descriptor : -1;
+        portPfd.revents = 0;
+        dataPfd = qt_make_pollfd(failed.at(i) || !readable ? -1 : d->ioThreadDataReadDescriptor, POLLIN);
+    };
+    for (qsizetype i = 0; i < privates.size(); ++i)
+        updateEvents(i);
+
+    bool interrupted = false;
+    while (readyPorts.isEmpty() && !interrupted && failed.contains(false)) {
+        const int ret = qt_safe_poll(pfds.data(), pfds.size(), deadline);
+        if (ret <= 0) {
+            const int errorCode = errno;
+            for (qsizetype i = 0; i < privates.size(); ++i) {
+                if (failed.at(i))
+                    continue;
+                privates.at(i)->setError(ret == 0
+                        ? QSerialPortErrorInfo(QSerialPort::TimeoutError)
+                        : privates.at(i)->getSystemError(errorCode));
+            }
+            break;
+        }
+
+        for (qsizetype i = 0; i < privates.size(); ++i) {
+            QSerialPortPrivate *d = privates.at(i);
+            const short portEvents = pfds.at(3 * i).revents;
+            const short dataEvents = pfds.at(3 * i + 1).revents;
+            if (pfds.at(3 * i + 2).revents & POLLIN) {
+                d->reportWaitInterrupted();
+                interrupted = true;
+            }
+            if (failed.at(i) || (portEvents == 0 && dataEvents == 0))
+                continue;
+
+            if ((portEvents | dataEvents) & POLLNVAL) {
+                d->setError(d->getSystemError(EBADF));
+                failed[i] = true;
+            } else if (!d->q_func()->isReadable()) {
+                // Hangups and errors of a write-only port are reported by the write
+                if (!d->completeAsyncWrite())
+                    failed[i] = true;
+            } else if ((portEvents & POLLOUT) && !d->completeAsyncWrite()) {
+                failed[i] = true;
+            } else if (d->ioThreadRing ? (dataEvents & POLLIN)
+                                       : (portEvents & (POLLIN | POLLHUP | POLLERR))) {
+                // Hangups and errors are reported by the read itself. A stale
+                // notification of the I/O thread reads nothing.
+                const qint64 receivedBytes = d->totalBytesReceived;
+                if (!d->readNotification()) {
+                    failed[i] = true;
+                } else if (d->totalBytesReceived != receivedBytes || d->frameDelimitingEnabled
+                           || (d->openMode & QIODevice::Unbuffered)) {
+                    // the blocking call does not wait for the readyRead() threshold
+                    d->emitHeldBackReadyRead();
+                    readyPorts.append(d->q_func());
+                }
+            }
+
+            updateEvents(i);
+        }
+    }
+
+    return readyPorts;
+}
+
+bool QSerialPortPrivate::openEventDescriptors(int *readDescriptor, int *writeDescriptor)
+{
+#if defined(Q_OS_LINUX)
+    *readDescriptor = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    *writeDescriptor = *readDescriptor;
+    return *readDescriptor != -1;
+#else
+    int pipes[2];
+    if (qt_safe_pipe(pipes, O_NONBLOCK) == -1)
+        return false;
+    *readDescriptor = pipes[0];
+    *writeDescriptor = pipes[1];
+    return true;
+#endif
+}
+
+void QSerialPortPrivate::closeEventDescriptors(int *readDescriptor, int *writeDescriptor)
+{
+    if (*writeDescriptor != *readDescriptor)
+        qt_safe_close(*writeDescriptor);
+    if (*readDescriptor != -1)
+        qt_safe_close(*readDescriptor);
+
+    *readDescriptor = -1;
+    *writeDescriptor = -1;
+}
+
+void QSerialPortPrivate::clearEvent(int readDescriptor)
+{
+    // An eventfd is reset by a single read, a pipe needs to be drained.
+    quint64 values[8];
+    while (qt_safe_read(readDescriptor, values, sizeof(values)) > 0) {
+    }
+}
+
+void QSerialPortPrivate::signalEvent(int writeDescriptor)
+{
+    // A full pipe or eventfd counter means the event is pending already.
+    const quint64 value = 1;
+    qt_safe_write(writeDescriptor, &value, sizeof(value));
+}
+
+int QSerialPortPrivate::readNotificationDescriptor() const
+{
+    return ioThreadRing ? ioThreadDataReadDescriptor : descriptor;
+}
+
+bool QSerialPortPrivate::createIoThread()
+{
+    if (!openEventDescriptors(&ioThreadDataReadDescriptor, &ioThreadDataWriteDescriptor))
+        return false;
+    if (!openEventDescriptors(&ioThreadWakeupReadDescriptor, &ioThreadWakeupWriteDescriptor)) {
+        const int errorCode = errno;
+        closeEventDescriptors(&ioThreadDataReadDescriptor, &ioThreadDataWriteDescriptor);
+        errno = errorCode;
+        return false;
+    }
+
+    ioThreadRing = std::make_unique<QSerialPortReceiveRing>(ioThreadRingSize);
+    ioThreadStopRequested.storeRelaxed(0);
+    ioThreadWaitingForRoom.storeRelaxed(0);
+    ioThreadFinished.storeRelaxed(0);
+    ioThreadErrorCode.storeRelaxed(0);
+    ioThread = std::make_unique<IoThread>(this);
+    return true;
+}
+
+void QSerialPortPrivate::stopIoThread()
+{
+    if (!ioThread)
+        return;
+
+    ioThreadStopRequested.storeRelease(1);
+    signalEvent(ioThreadWakeupWriteDescriptor);
+    ioThread->wait();
+    ioThread.reset();
+    ioThreadRing.reset();
+
+    closeEventDescriptors(&ioThreadDataReadDescriptor, &ioThreadDataWriteDescriptor);
+    closeEventDescriptors(&ioThreadWakeupReadDescriptor, &ioThreadWakeupWriteDescriptor);
+}
+
+void QSerialPortPrivate::resumeIoThread()
+{
+    // Called after taking data from the ring, see runIoThread()
+    if (ioThreadWaitingForRoom.testAndSetOrdered(1, 0))
+        signalEvent(ioThreadWakeupWriteDescriptor);
+}
+
+bool QSerialPortPrivate::acquireReactor()
+{
+#ifdef Q_OS_LINUX
+    reactor = QSerialPortReactor::acquire();
+    return reactor != nullptr;
+#else
+    return true;
+#endif
+}
+
+void QSerialPortPrivate::releaseReactor()
+{
+#ifdef Q_OS_LINUX
+    if (!reactor)
+        return;
+
+    reactor->removePort(this);
+    std::exchange(reactor, nullptr)->release();
+    reactorReadEnabled = false;
+    reactorWriteEnabled = false;
+#endif
+}
+
+void QSerialPortPrivate::updateReactor()
+{
+#ifdef Q_OS_LINUX
+    if (reactor->updatePort(this))
+        return;
+
+    // The descriptor can not be watched by epoll, so the port falls back
+    // to its own notifiers with the requested notifications.
+    const bool readEnabled = reactorReadEnabled;
+    const bool writeEnabled = reactorWriteEnabled;
+    releaseReactor();
+    setReadNotificationEnabled(readEnabled);
+    setWriteNotificationEnabled(writeEnabled);
+#endif
+}
+
+void QSerialPortPrivate::runIoThread()
+{
+    pollfd pfds[2] = {
+        qt_make_pollfd(descriptor, POLLIN),
+        qt_make_pollfd(ioThreadWakeupReadDescriptor, POLLIN)
+    };
+
+    while (!ioThreadStopRequested.loadAcquire()) {
+        // Stop reading while the ring is full, the owner thread signals the
+        // wakeup once it makes room. The flag is raised before checking the
+        // ring again, so that the owner cannot miss it.
+        pfds[0].fd = descriptor;
+        if (ioThreadRing->isFull()) {
+            ioThreadWaitingForRoom.fetchAndStoreOrdered(1);
+            if (ioThreadRing->isFull())
+                pfds[0].fd = -1;
+            else
+                ioThreadWaitingForRoom.storeRelaxed(0);
+        }
+
+        if (qt_safe_poll(pfds, 2, QDeadlineTimer(QDeadlineTimer::Forever)) < 0) {
+            ioThreadErrorCode.storeRelaxed(errno);
+            break;
+        }
+
+        if (pfds[1].revents & POLLIN)
+            clearEvent(ioThreadWakeupReadDescriptor);
+
+        if (pfds[0].fd == -1 || pfds[0].revents == 0)
+            continue;
+
+        const qint64 readBytes = ioThreadRing->readFromDescriptor(descriptor);
+        if (readBytes > 0) {
+            signalEvent(ioThreadDataWriteDescriptor);
+            continue;
+        }
+        if (readBytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            continue;
+
+        // The owner thread reports the error, or the end of the data,
+        // once it has taken the data left in the ring.
+        ioThreadErrorCode.storeRelaxed(readBytes < 0 ? errno : 0);
+        break;
+    }
+
+    ioThreadFinished.storeRelease(1);
+    signalEvent(ioThreadDataWriteDescriptor);
+}
+
+void QSerialPortPrivate::interruptWait()
+{
+    // The flag is raised first, so that a wait which creates the
+    // descriptor meanwhile sees the interruption either way.
+    waitInterrupted.storeRelease(1);
+
+    const QMutexLocker locker(&wakeupMutex);
+    if (wakeupWriteDescriptor != -1)
+        signalEvent(wakeupWriteDescriptor);
+}
+
+bool QSerialPortPrivate::startInterruptibleWait()
+{
+    {
+        const QMutexLocker locker(&wakeupMutex);
+        // Without the descriptor, only the interruptions which
+        // are pending when the wait starts are noticed.
+        if (wakeupReadDescriptor == -1)
+            openEventDescriptors(&wakeupReadDescriptor, &wakeupWriteDescriptor);
+    }
+
+    if (waitInterrupted.loadAcquire()) {
+        reportWaitInterrupted();
+        return false;
+    }
+    return true;
+}
+
+void QSerialPortPrivate::reportWaitInterrupted()
+{
+    waitInterrupted.storeRelaxed(0);
+    if (wakeupReadDescriptor != -1)
+        clearEvent(wakeupReadDescriptor);
+    setError(QSerialPortErrorInfo(QSerialPort::TimeoutError, QSerialPort::tr("Wait interrupted")));
+}
+
+bool QSerialPortPrivate::sleepInterruptibly(QDeadlineTimer deadline)
+{
+    if (!startInterruptibleWait())
+        return false;
+
+    pollfd pfd = qt_make_pollfd(wakeupReadDescriptor, POLLIN);
+    const int ret = qt_safe_poll(&pfd, 1, deadline);
+    if (ret < 0) {
+        setError(getSystemError());
+        return false;
+    }
+    if (ret > 0 && (pfd.revents & POLLIN)) {
+        reportWaitInterrupted();
+        return false;
+    }
+    return true;
+}
+
+qint64 QSerialPortPrivate::queuedBytesCount(QSerialPort::Direction direction) const
+{
+    int count = 0;
+    if (direction == QSerialPort::Input) {
+        if (::ioctl(descriptor, FIONREAD, &count) == -1)
+            return -1;
+    } else if (direction == QSerialPort::Output) {
+        if (::ioctl(descriptor, TIOCOUTQ, &count) == -1)
+            return -1;
+    } else {
+        return -1;
+    }
+
+    // The data taken by the I/O thread is still queued for the user
+    if (direction == QSerialPort::Input && ioThreadRing)
+        return count + qint64(ioThreadRing->size());
+    return count;
+}
+
+bool QSerialPortPrivate::isTransmitComplete() const
+{
+    // Assume the data has been transmitted if the driver cannot tell
+    if (queuedBytesCount(QSerialPort::Output) > 0)
+        return false;
+
+#if defined(TIOCSERGETLSR) && defined(TIOCSER_TEMT)
+    // The transmitter shift register might still hold the last character
+    unsigned int lineStatus = 0;
+    if (::ioctl(descriptor, TIOCSERGETLSR, &lineStatus) != -1 && !(lineStatus & TIOCSER_TEMT))
+        return false;
+#endif
+
     return true;
 }
 
 qint64 QSerialPortPrivate::readFromPort(char *data, qint64 maxSize)
 {
-    return qt_safe_read(descriptor, data, maxSize);
+    if (!ioThreadRing)
+        return qt_safe_read(descriptor, data, maxSize);
+
+    // Take the data from the I/O thread, and behave like a non-blocking
+    // read of the port once the ring is empty.
+    const bool finished = ioThreadFinished.loadAcquire();
+    const qint64 readBytes = ioThreadRing->read(data, maxSize);
+    if (readBytes > 0) {
+        resumeIoThread();
+        return readBytes;
+    }
+
+    if (!finished) {
+        errno = EAGAIN;
+        return -1;
+    }
+    const int errorCode = ioThreadErrorCode.loadRelaxed();
+    if (errorCode == 0)
+        return 0;
+    errno = errorCode;
+    return -1;
 }
 
 qint64 QSerialPortPrivate::writeToPort(const char *data, qint64 maxSize)
@@ -1039,45 +2259,96 @@ qint64 QSerialPortPrivate::writeToPort(const char *data, qint64 maxSize)
     return bytesWritten;
 }
 
-#ifndef CMSPAR
-
-static inline bool evenParity(quint8 c)
+qint64 QSerialPortPrivate::writeBufferToPort(qint64 maxSize)
 {
-    c ^= c >> 4;        //(c7 ^ c3)(c6 ^ c2)(c5 ^ c1)(c4 ^ c0)
-    c ^= c >> 2;        //[(c7 ^ c3)(c5 ^ c1)][(c6 ^ c2)(c4 ^ c0)]
-    c ^= c >> 1;
-    return c & 1;       //(c7 ^ c3)(c5 ^ c1)(c6 ^ c2)(c4 ^ c0)
+    maxSize = qMin(maxSize, writeBuffer.size());
+
+#if !defined(CMSPAR)
+    // The parity emulation writes the data per character anyway.
+    if (parity == QSerialPort::MarkParity || parity == QSerialPort::SpaceParity)
+        return writePerChar(writeBuffer.readPointer(), qMin(writeBuffer.nextDataBlockSize(), maxSize));
+#endif
+
+    if (writeBuffer.nextDataBlockSize() >= maxSize)
+        return writeToPort(writeBuffer.readPointer(), maxSize);
+
+#if defined(IOV_MAX)
+    constexpr int maxIovecCount = IOV_MAX;
+#else
+    constexpr int maxIovecCount = 16; // the minimum required by POSIX
+#endif
+
+    // Gather the chunks of the write buffer to write them all at once.
+    QVarLengthArray<iovec, 64> iov;
+    for (qint64 pos = 0; pos < maxSize && iov.size() < maxIovecCount;) {
+        qint64 length = 0;
+        const char *ptr = writeBuffer.readPointerAtPosition(pos, length);
+        length = qMin(length, maxSize - pos);
+        iov.append({const_cast<char *>(ptr), size_t(length)});
+        pos += length;
+    }
+
+    qint64 bytesWritten = 0;
+    EINTR_LOOP(bytesWritten, ::writev(descriptor, iov.constData(), int(iov.size())));
+    return bytesWritten;
 }
 
+#ifndef CMSPAR
+
+// The parity bit for even parity of each byte value, that is,
+// whether the number of set bits is odd.
+static constexpr auto evenParityTable = [] {
+    std::array<bool, 256> table = {};
+    for (int c = 0; c < 256; ++c) {
+        bool par = false;
+        for (int bits = c; bits; bits >>= 1)
+            par ^= bits & 1;
+        table[c] = par;
+    }
+    return table;
+}();
+
 qint64 QSerialPortPrivate::writePerChar(const char *data, qint64 maxSize)
 {
     termios tio;
     if (!getTermios(&tio))
         return -1;
 
-    qint64 ret = 0;
     quint8 const charMask = (0xFF >> (8 - dataBits));
+    const bool markParity = parity == QSerialPort::MarkParity;
 
-    while (ret < maxSize) {
+    // False if need EVEN, true if need ODD.
+    const auto needsOddParity = [&](char c) {
+        return evenParityTable[quint8(c) & charMask] != markParity;
+    };
 
-        bool par = evenParity(*data & charMask);
-        // False if need EVEN, true if need ODD.
-        par ^= parity == QSerialPort::MarkParity;
-        if (par ^ (tio.c_cflag & PARODD)) { // Need switch parity mode?
+    qint64 ret = 0;
+    while (ret < maxSize) {
+        // Write the run of characters which need the same parity mode at once
+        const bool par = needsOddParity(data[ret]);
+        qint64 runEnd = ret + 1;
+        while (runEnd < maxSize && needsOddParity(data[runEnd]) == par)
+            ++runEnd;
+
+        if (par != bool(tio.c_cflag & PARODD)) { // Need switch parity mode?
+            // The switch blocks until the driver queue is drained, so do
+            // one per call and let the event loop run in between.
+            if (ret > 0)
+                break;
             tio.c_cflag ^= PARODD;
-            flush(); //force sending already buffered data, because setTermios(&tio); cleares buffers
-            //todo: add receiving buffered data!!!
-            if (!setTermios(&tio))
+            // Switch once the characters written so far have been transmitted
+            if (::tcsetattr(descriptor, TCSADRAIN, &tio) == -1) {
+                setError(getSystemError());
                 break;
+            }
         }
 
-        int r = qt_safe_write(descriptor, data, 1);
+        const qint64 r = qt_safe_write(descriptor, data + ret, runEnd - ret);
         if (r < 0)
-            return -1;
-        if (r > 0) {
-            data += r;
-            ret += r;
-        }
+            return ret > 0 ? ret : -1;
+        ret += r;
+        if (ret < runEnd) // the driver queue is full
+            break;
     }
     return ret;
 }
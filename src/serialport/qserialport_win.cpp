@@ -10,6 +10,7 @@
 #include <QtCore/qelapsedtimer.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
 #include <QtCore/qtimer.h>
 #include <algorithm>
 
@@ -252,6 +253,14 @@ bool QSerialPortPrivate::setRequestToSend(bool set)
     return setDcb(&dcb);
 }
 
+bool QSerialPortPrivate::setRs485Settings(const QSerialPort::Rs485Settings &settings)
+{
+    Q_UNUSED(settings);
+    setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                                  QSerialPort::tr("RS-485 mode is not supported")));
+    return false;
+}
+
 bool QSerialPortPrivate::flush()
 {
     return _q_startAsyncWrite();
@@ -303,6 +312,9 @@ bool QSerialPortPrivate::setBreakEnabled(bool set)
 
 bool QSerialPortPrivate::waitForReadyRead(int msecs)
 {
+    // The application might have consumed enough data to resume the sender
+    updateReadThrottling();
+
     if (!writeStarted && !_q_startAsyncWrite())
         return false;
 
@@ -335,7 +347,7 @@ bool QSerialPortPrivate::waitForReadyRead(int msecs)
 
 bool QSerialPortPrivate::waitForBytesWritten(int msecs)
 {
-    if (writeBuffer.isEmpty() && writeChunkBuffer.isEmpty())
+    if (writeBuffer.isEmpty() && urgentWriteBuffer.isEmpty() && writeChunkBuffer.isEmpty())
         return false;
 
     if (!writeStarted && !_q_startAsyncWrite())
@@ -436,8 +448,11 @@ bool QSerialPortPrivate::completeAsyncRead(qint64 bytesTransferred)
         readStarted = false;
         return false;
     }
-    if (bytesTransferred > 0)
+    if (bytesTransferred > 0) {
         buffer.append(readChunkBuffer.constData(), bytesTransferred);
+        recordReceivedData(bytesTransferred);
+        updateReadThrottling();
+    }
 
     readStarted = false;
 
@@ -469,6 +484,8 @@ bool QSerialPortPrivate::completeAsyncWrite(qint64 bytesTransferred)
         writeChunkBuffer.clear();
         emit q->bytesWritten(bytesTransferred);
         writeStarted = false;
+        if (writeBuffer.isEmpty() && urgentWriteBuffer.isEmpty())
+            startTransmitPolling();
     }
 
     return _q_startAsyncWrite();
@@ -539,10 +556,11 @@ bool QSerialPortPrivate::_q_startAsyncWrite()
         return false;
     }
 
-    if (writeBuffer.isEmpty() || writeStarted)
+    if ((writeBuffer.isEmpty() && urgentWriteBuffer.isEmpty()) || writeStarted)
         return true;
 
-    writeChunkBuffer = writeBuffer.read();
+    // The urgent data goes out before the rest of the write buffer.
+    writeChunkBuffer = urgentWriteBuffer.isEmpty() ? writeBuffer.read() : urgentWriteBuffer.read();
     ::ZeroMemory(&writeCompletionOverlapped, sizeof(writeCompletionOverlapped));
     if (!::WriteFile(handle, writeChunkBuffer.constData(),
                      writeChunkBuffer.size(), nullptr, &writeCompletionOverlapped)) {
@@ -589,20 +607,43 @@ qint64 QSerialPortPrivate::writeData(const char *data, qint64 maxSize)
 {
     Q_Q(QSerialPort);
 
-    writeBuffer.append(data, maxSize);
+    // Shares the payload passed to QIODevice::write(const QByteArray &)
+    QIODevicePrivate::write(data, maxSize);
 
     if (!writeBuffer.isEmpty() && !writeStarted) {
+        // Start the overlapped write without waiting for the event loop
+        if (immediateWriteEnabled) {
+            if (startAsyncWriteTimer)
+                startAsyncWriteTimer->stop();
+            // The data is queued already, so returning -1 would make the
+            // caller write it again. A failure is reported by the error.
+            _q_startAsyncWrite();
+            return maxSize;
+        }
         if (!startAsyncWriteTimer) {
             startAsyncWriteTimer = new QTimer(q);
             QObjectPrivate::connect(startAsyncWriteTimer, &QTimer::timeout, this, &QSerialPortPrivate::_q_startAsyncWrite);
             startAsyncWriteTimer->setSingleShot(true);
         }
-        if (!startAsyncWriteTimer->isActive())
-            startAsyncWriteTimer->start();
+        if (writeCoalescingMaxBytes <= 0 || writeBuffer.size() >= writeCoalescingMaxBytes)
+            startAsyncWriteTimer->start(0);
+        else if (!startAsyncWriteTimer->isActive())
+            startAsyncWriteTimer->start(writeCoalescingMaxDelay);
     }
     return maxSize;
 }
 
+qint64 QSerialPortPrivate::writeUrgentData(const char *data, qint64 maxSize)
+{
+    urgentWriteBuffer.append(data, maxSize);
+
+    // The urgent data is never held back. As it is queued already,
+    // a failure to start the write is reported by the error only.
+    if (!urgentWriteBuffer.isEmpty() && !writeStarted)
+        _q_startAsyncWrite();
+    return maxSize;
+}
+
 OVERLAPPED *QSerialPortPrivate::waitForNotified(QDeadlineTimer deadline)
 {
     OVERLAPPED *overlapped = notifier->waitForAnyNotified(deadline);
@@ -613,6 +654,30 @@ OVERLAPPED *QSerialPortPrivate::waitForNotified(QDeadlineTimer deadline)
     return overlapped;
 }
 
+QList<QSerialPort *> QSerialPortPrivate::waitForAnyReadyRead(const QList<QSerialPort *> &ports,
+                                                             QDeadlineTimer deadline)
+{
+    Q_UNUSED(deadline);
+
+    for (QSerialPort *port : ports) {
+        if (port && port->isOpen()) {
+            port->d_func()->setError(QSerialPortErrorInfo(QSerialPort::UnsupportedOperationError,
+                    QSerialPort::tr("Waiting on several ports is not supported on this platform")));
+        }
+    }
+    return {};
+}
+
+void QSerialPortPrivate::interruptWait()
+{
+}
+
+bool QSerialPortPrivate::sleepInterruptibly(QDeadlineTimer deadline)
+{
+    QThread::sleep(deadline.remainingTimeAsDuration());
+    return true;
+}
+
 qint64 QSerialPortPrivate::queuedBytesCount(QSerialPort::Direction direction) const
 {
     COMSTAT comstat;
@@ -623,6 +688,12 @@ qint64 QSerialPortPrivate::queuedBytesCount(QSerialPort::Direction direction) co
             : ((direction == QSerialPort::Output) ? comstat.cbOutQue : -1);
 }
 
+bool QSerialPortPrivate::isTransmitComplete() const
+{
+    // Assume the data has been transmitted if the driver cannot tell
+    return queuedBytesCount(QSerialPort::Output) <= 0;
+}
+
 inline bool QSerialPortPrivate::initialize(QIODevice::OpenMode mode)
 {
     Q_Q(QSerialPort);
@@ -643,6 +714,9 @@ inline bool QSerialPortPrivate::initialize(QIODevice::OpenMode mode)
     if (!setDcb(&dcb))
         return false;
 
+    if (rs485SettingsSet && !setRs485Settings(rs485Settings))
+        return false;
+
     if (!::GetCommTimeouts(handle, &restoredCommTimeouts)) {
         setError(getSystemError());
         return false;
@@ -99,6 +99,30 @@ private slots:
 
     void readBufferOverflow();
     void readAfterInputClear();
+    void takeChunk();
+    void adaptiveReadChunkPolicy();
+    void readDrainLimits();
+    void readyReadThreshold();
+    void frameDelimiting();
+    void readWithTimestamps();
+    void lineDelimiter();
+    void readBufferWatermarks();
+    void unbufferedReadWrite();
+    void immediateWrite();
+    void writeCoalescing();
+    void waitForTransmitted();
+    void rs485Settings();
+    void rs485SettingsDisabled();
+    void rs485SettingsAfterOpen();
+    void urgentPriorityWrite();
+    void writePacing();
+    void bytesInDriver();
+    void waitForBytesAvailableAndDelimiter();
+    void waitForAnyReadyRead();
+    void busyPoll();
+    void interruptWait();
+    void ioThread();
+    void sharedReactor();
     void synchronousReadWriteAfterAsynchronousReadWrite();
 
     void controlBreak();
@@ -240,6 +264,11 @@ void tst_QSerialPort::openExisting_data()
     QTest::newRow("Truncate") << int(QIODevice::Truncate) << false << QSerialPort::UnsupportedOperationError;
     QTest::newRow("Text") << int(QIODevice::Text) << false << QSerialPort::UnsupportedOperationError;
     QTest::newRow("Unbuffered") << int(QIODevice::Unbuffered) << false << QSerialPort::UnsupportedOperationError;
+#if defined(Q_OS_WIN)
+    QTest::newRow("ReadWriteUnbuffered") << int(QIODevice::ReadWrite | QIODevice::Unbuffered) << false << QSerialPort::UnsupportedOperationError;
+#else
+    QTest::newRow("ReadWriteUnbuffered") << int(QIODevice::ReadWrite | QIODevice::Unbuffered) << true << QSerialPort::NoError;
+#endif
 }
 
 void tst_QSerialPort::openExisting()
@@ -1026,6 +1055,901 @@ void tst_QSerialPort::readAfterInputClear()
     QVERIFY(receiverPort.bytesAvailable() == 0);
 }
 
+void tst_QSerialPort::takeChunk()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("takeChunk.*: device not open"));
+    QVERIFY(senderPort.takeChunk().isEmpty());
+    QCOMPARE(senderPort.error(), QSerialPort::NotOpenError);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+    QVERIFY(senderPort.peekChunk().isEmpty());
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("takeChunk.*: WriteOnly device"));
+    QVERIFY(senderPort.takeChunk().isEmpty());
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    QVERIFY(receiverPort.peekChunk().isEmpty());
+    QVERIFY(receiverPort.takeChunk().isEmpty());
+
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY2(senderPort.waitForBytesWritten(100), "Waiting for bytes written failed");
+
+    while (receiverPort.bytesAvailable() < alphabetArray.size())
+        QVERIFY(receiverPort.waitForReadyRead(100));
+
+    QByteArray readData;
+    while (receiverPort.bytesAvailable() > 0) {
+        const QByteArray peeked = receiverPort.peekChunk().toByteArray();
+        QVERIFY(!peeked.isEmpty());
+        const QByteArray chunk = receiverPort.takeChunk();
+        QCOMPARE(chunk, peeked);
+        readData += chunk;
+    }
+
+    QCOMPARE(readData, alphabetArray);
+    QVERIFY(receiverPort.peekChunk().isEmpty());
+}
+
+void tst_QSerialPort::adaptiveReadChunkPolicy()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QCOMPARE(receiverPort.readChunkPolicy(), QSerialPort::FixedReadChunk);
+    receiverPort.setReadChunkPolicy(QSerialPort::AdaptiveReadChunk);
+    QCOMPARE(receiverPort.readChunkPolicy(), QSerialPort::AdaptiveReadChunk);
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY2(senderPort.waitForBytesWritten(100), "Waiting for bytes written failed");
+
+    QByteArray readData;
+    while ((readData.size() < alphabetArray.size()) && receiverPort.waitForReadyRead(100))
+        readData.append(receiverPort.readAll());
+
+    QCOMPARE(readData, alphabetArray);
+}
+
+void tst_QSerialPort::readDrainLimits()
+{
+#ifdef Q_OS_WIN
+    QSKIP("Read drain limits are not supported on Windows");
+#endif
+
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QCOMPARE(receiverPort.readDrainMaxBytes(), qint64(0));
+    QCOMPARE(receiverPort.readDrainMaxDuration(), std::chrono::microseconds::zero());
+    receiverPort.setReadDrainLimits(4096, std::chrono::microseconds(500));
+    QCOMPARE(receiverPort.readDrainMaxBytes(), qint64(4096));
+    QCOMPARE(receiverPort.readDrainMaxDuration(), std::chrono::microseconds(500));
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    AsyncReader2 reader(receiverPort, alphabetArray);
+    QSignalSpy readyReadSpy(&receiverPort, &QSerialPort::readyRead);
+    QVERIFY(readyReadSpy.isValid());
+
+    // Let the whole burst reach the receiving driver before the event loop
+    // runs, so that it is drained by a single notification.
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY2(senderPort.waitForBytesWritten(500), "Waiting for bytes written failed");
+    QVERIFY2(senderPort.waitForTransmitted(1000), "Waiting for bytes transmitted failed");
+    QThread::msleep(50);
+
+    enterLoop(1);
+    QVERIFY2(!timeout(), "Timed out when waiting for the read.");
+    QCOMPARE(readyReadSpy.size(), 1);
+}
+
+void tst_QSerialPort::readyReadThreshold()
+{
+#ifdef Q_OS_WIN
+    QSKIP("The readyRead() threshold is not supported on Windows");
+#endif
+
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    receiverPort.setReadyReadThreshold(alphabetArray.size(), std::chrono::milliseconds(1000));
+    QCOMPARE(receiverPort.readyReadThreshold(), qint64(alphabetArray.size()));
+    QCOMPARE(receiverPort.readyReadMaxDelay(), std::chrono::milliseconds(1000));
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    QSignalSpy readyReadSpy(&receiverPort, &QSerialPort::readyRead);
+    QVERIFY(readyReadSpy.isValid());
+    AsyncReader reader(receiverPort, Qt::DirectConnection, alphabetArray.size());
+
+    for (const char c : alphabetArray)
+        QCOMPARE(senderPort.write(&c, 1), qint64(1));
+
+    enterLoop(1);
+    QVERIFY2(!timeout(), "Timed out when waiting for the read.");
+    QCOMPARE(readyReadSpy.size(), 1);
+    QCOMPARE(receiverPort.readAll(), alphabetArray);
+
+    // the delay bounds the latency when the threshold is not reached
+    receiverPort.setReadyReadThreshold(alphabetArray.size() * 2, std::chrono::milliseconds(100));
+    AsyncReader reader2(receiverPort, Qt::DirectConnection, newlineArray.size());
+    QCOMPARE(senderPort.write(newlineArray), qint64(newlineArray.size()));
+
+    enterLoop(1);
+    QVERIFY2(!timeout(), "Timed out when waiting for the delayed readyRead().");
+    QCOMPARE(receiverPort.readAll(), newlineArray);
+
+    // without a delay, the held back readyRead() is still emitted by the blocking call
+    receiverPort.setReadyReadThreshold(alphabetArray.size() * 2, std::chrono::milliseconds::zero());
+    readyReadSpy.clear();
+    QCOMPARE(senderPort.write(newlineArray), qint64(newlineArray.size()));
+    QVERIFY2(senderPort.waitForBytesWritten(500), "Waiting for bytes written failed");
+
+    QVERIFY(receiverPort.waitForReadyRead(500));
+    QCOMPARE(readyReadSpy.size(), 1);
+}
+
+void tst_QSerialPort::frameDelimiting()
+{
+#ifdef Q_OS_WIN
+    QSKIP("The frame delimiting mode is not supported on Windows");
+#endif
+
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(!receiverPort.isFrameDelimitingEnabled());
+    QCOMPARE(receiverPort.interFrameTimeout(), std::chrono::microseconds::zero());
+    receiverPort.setFrameDelimitingEnabled(true);
+    QVERIFY(receiverPort.isFrameDelimitingEnabled());
+    // USB adapters deliver data with a latency of several milliseconds
+    receiverPort.setInterFrameTimeout(std::chrono::milliseconds(50));
+    QCOMPARE(receiverPort.interFrameTimeout(), std::chrono::microseconds(50000));
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    QSignalSpy frameSpy(&receiverPort, &QSerialPort::frameReceived);
+    QVERIFY(frameSpy.isValid());
+    QSignalSpy readyReadSpy(&receiverPort, &QSerialPort::readyRead);
+    QVERIFY(readyReadSpy.isValid());
+
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY2(senderPort.waitForBytesWritten(100), "Waiting for bytes written failed");
+    QTRY_COMPARE(frameSpy.size(), 1);
+
+    QCOMPARE(senderPort.write(newlineArray), qint64(newlineArray.size()));
+    QVERIFY2(senderPort.waitForBytesWritten(100), "Waiting for bytes written failed");
+    QTRY_COMPARE(frameSpy.size(), 2);
+
+    QCOMPARE(qvariant_cast<QByteArray>(frameSpy.at(0).at(0)), alphabetArray);
+    QCOMPARE(qvariant_cast<QByteArray>(frameSpy.at(1).at(0)), newlineArray);
+    QCOMPARE(readyReadSpy.size(), 0);
+    QCOMPARE(receiverPort.bytesAvailable(), qint64(0));
+
+    // the blocking call returns once a frame is complete
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY2(senderPort.waitForBytesWritten(100), "Waiting for bytes written failed");
+    QVERIFY(receiverPort.waitForReadyRead(1000));
+    QCOMPARE(frameSpy.size(), 3);
+    QCOMPARE(qvariant_cast<QByteArray>(frameSpy.at(2).at(0)), alphabetArray);
+
+    // closing the port delivers the partial frame
+    receiverPort.setInterFrameTimeout(std::chrono::seconds(5));
+    QCOMPARE(senderPort.write(newlineArray), qint64(newlineArray.size()));
+    QVERIFY2(senderPort.waitForBytesWritten(100), "Waiting for bytes written failed");
+    QVERIFY(!receiverPort.waitForReadyRead(200));
+    QCOMPARE(frameSpy.size(), 3);
+    receiverPort.close();
+    QCOMPARE(frameSpy.size(), 4);
+    QCOMPARE(qvariant_cast<QByteArray>(frameSpy.at(3).at(0)), newlineArray);
+}
+
+void tst_QSerialPort::readWithTimestamps()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(!receiverPort.isReceiveTimestampsEnabled());
+    receiverPort.setReceiveTimestampsEnabled(true);
+    QVERIFY(receiverPort.isReceiveTimestampsEnabled());
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    const auto beforeWrite = std::chrono::steady_clock::now();
+
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY2(senderPort.waitForBytesWritten(100), "Waiting for bytes written failed");
+
+    while (receiverPort.bytesAvailable() < alphabetArray.size())
+        QVERIFY(receiverPort.waitForReadyRead(100));
+
+    const auto afterRead = std::chrono::steady_clock::now();
+
+    // consume a part of the first chunk before reading the rest
+    QByteArray readData = receiverPort.read(1);
+
+    const QList<QSerialPort::TimestampedData> chunks = receiverPort.readWithTimestamps();
+    QVERIFY(!chunks.isEmpty());
+
+    auto previousTimestamp = beforeWrite;
+    for (const QSerialPort::TimestampedData &chunk : chunks) {
+        QVERIFY(!chunk.data().isEmpty());
+        QVERIFY(chunk.timestamp() >= previousTimestamp);
+        QVERIFY(chunk.timestamp() <= afterRead);
+        previousTimestamp = chunk.timestamp();
+        readData += chunk.data();
+    }
+
+    QCOMPARE(readData, alphabetArray);
+    QCOMPARE(receiverPort.bytesAvailable(), qint64(0));
+    QVERIFY(receiverPort.readWithTimestamps().isEmpty());
+}
+
+void tst_QSerialPort::lineDelimiter()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QCOMPARE(receiverPort.lineDelimiter(), QByteArray("\n"));
+    receiverPort.setLineDelimiter("\r\n");
+    QCOMPARE(receiverPort.lineDelimiter(), QByteArray("\r\n"));
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    // The delimiter is split between two incoming chunks.
+    const QByteArray firstPart("$GPGGA,1\r");
+    QCOMPARE(senderPort.write(firstPart), qint64(firstPart.size()));
+    QVERIFY(senderPort.waitForBytesWritten(100));
+    while (receiverPort.bytesAvailable() < firstPart.size())
+        QVERIFY(receiverPort.waitForReadyRead(100));
+    QVERIFY(!receiverPort.canReadDelimitedLine());
+
+    const QByteArray secondPart("\n$GPRMC\n,2\r\n");
+    QCOMPARE(senderPort.write(secondPart), qint64(secondPart.size()));
+    QVERIFY(senderPort.waitForBytesWritten(100));
+    while (receiverPort.bytesAvailable() < firstPart.size() + secondPart.size())
+        QVERIFY(receiverPort.waitForReadyRead(100));
+
+    QVERIFY(receiverPort.canReadDelimitedLine());
+    QCOMPARE(receiverPort.readDelimitedLine(), QByteArray("$GPGGA,1\r\n"));
+    QVERIFY(receiverPort.canReadDelimitedLine());
+    QCOMPARE(receiverPort.readDelimitedLine(4), QByteArray("$GPR"));
+    QCOMPARE(receiverPort.readDelimitedLine(), QByteArray("MC\n,2\r\n"));
+    QVERIFY(!receiverPort.canReadDelimitedLine());
+
+    receiverPort.setLineDelimiter(";");
+    const QByteArray records("a;bc;d");
+    QCOMPARE(senderPort.write(records), qint64(records.size()));
+    QVERIFY(senderPort.waitForBytesWritten(100));
+    while (receiverPort.bytesAvailable() < records.size())
+        QVERIFY(receiverPort.waitForReadyRead(100));
+
+    // canReadLine() keeps following readLine(), which stops at '\n'
+    QVERIFY(receiverPort.canReadDelimitedLine());
+    QVERIFY(!receiverPort.canReadLine());
+    QCOMPARE(receiverPort.readDelimitedLine(), QByteArray("a;"));
+    QCOMPARE(receiverPort.readDelimitedLine(), QByteArray("bc;"));
+    QVERIFY(!receiverPort.canReadDelimitedLine());
+    QCOMPARE(receiverPort.readDelimitedLine(), QByteArray("d"));
+
+    const QByteArray line("e;f\n");
+    QCOMPARE(senderPort.write(line), qint64(line.size()));
+    QVERIFY(senderPort.waitForBytesWritten(100));
+    while (!receiverPort.canReadLine())
+        QVERIFY(receiverPort.waitForReadyRead(100));
+    QCOMPARE(receiverPort.readLine(), line);
+}
+
+void tst_QSerialPort::readBufferWatermarks()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    receiverPort.setReadBufferWatermarks(32, 4);
+    QCOMPARE(receiverPort.readBufferHighWatermark(), qint64(4));
+    QCOMPARE(receiverPort.readBufferLowWatermark(), qint64(4));
+    receiverPort.setReadBufferWatermarks(2, 8);
+    QCOMPARE(receiverPort.readBufferLowWatermark(), qint64(2));
+    QCOMPARE(receiverPort.readBufferHighWatermark(), qint64(8));
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+    QVERIFY(!receiverPort.isReadThrottled());
+
+    QSignalSpy throttledSpy(&receiverPort, &QSerialPort::readThrottledChanged);
+    QVERIFY(throttledSpy.isValid());
+
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY2(senderPort.waitForBytesWritten(100), "Waiting for bytes written failed");
+
+    while (receiverPort.bytesAvailable() < 8)
+        QVERIFY(receiverPort.waitForReadyRead(100));
+
+    QVERIFY(receiverPort.isReadThrottled());
+    QCOMPARE(throttledSpy.size(), 1);
+    QCOMPARE(throttledSpy.at(0).at(0).toBool(), true);
+
+    // a read that leaves data in the buffer is only taken into account
+    // by the next check, such as the one before a blocking wait
+    QByteArray readData = receiverPort.read(receiverPort.bytesAvailable() - 2);
+    QVERIFY(receiverPort.isReadThrottled());
+    receiverPort.waitForReadyRead(10);
+    QVERIFY(throttledSpy.size() >= 2);
+    QCOMPARE(throttledSpy.at(1).at(0).toBool(), false);
+
+    while (readData.size() < alphabetArray.size()) {
+        readData += receiverPort.readAll();
+        if (readData.size() < alphabetArray.size())
+            QVERIFY(receiverPort.waitForReadyRead(100));
+    }
+    QCOMPARE(readData, alphabetArray);
+
+    QVERIFY(!receiverPort.isReadThrottled());
+    QVERIFY(throttledSpy.size() >= 2);
+    QCOMPARE(throttledSpy.last().at(0).toBool(), false);
+}
+
+void tst_QSerialPort::unbufferedReadWrite()
+{
+#ifdef Q_OS_WIN
+    QSKIP("The unbuffered mode is not supported on Windows.");
+#endif
+
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly | QSerialPort::Unbuffered));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly | QSerialPort::Unbuffered));
+
+    QSignalSpy bytesWrittenSpy(&senderPort, &QSerialPort::bytesWritten);
+    QVERIFY(bytesWrittenSpy.isValid());
+
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    // The data is passed to the driver directly
+    QCOMPARE(senderPort.bytesToWrite(), qint64(0));
+    QVERIFY2(senderPort.waitForBytesWritten(100), "Waiting for bytes written failed");
+    QCOMPARE(bytesWrittenSpy.size(), 1);
+    QCOMPARE(bytesWrittenSpy.at(0).at(0).toLongLong(), qint64(alphabetArray.size()));
+
+    QByteArray readData;
+    while (readData.size() < alphabetArray.size()) {
+        QVERIFY(receiverPort.waitForReadyRead(100));
+        char data[64];
+        const qint64 readBytes = receiverPort.read(data, sizeof(data));
+        QVERIFY(readBytes > 0);
+        readData.append(data, readBytes);
+    }
+
+    QCOMPARE(readData, alphabetArray);
+    QCOMPARE(receiverPort.bytesAvailable(), qint64(0));
+}
+
+void tst_QSerialPort::immediateWrite()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(!senderPort.isImmediateWriteEnabled());
+    senderPort.setImmediateWriteEnabled(true);
+    QVERIFY(senderPort.isImmediateWriteEnabled());
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    QSignalSpy bytesWrittenSpy(&senderPort, &QSerialPort::bytesWritten);
+    QVERIFY(bytesWrittenSpy.isValid());
+
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+#ifndef Q_OS_WIN
+    QCOMPARE(senderPort.bytesToWrite(), qint64(0));
+#endif
+
+    // The data arrives without the sender returning to the event loop
+    QByteArray readData;
+    while (readData.size() < alphabetArray.size()) {
+        QVERIFY(receiverPort.waitForReadyRead(100));
+        readData += receiverPort.readAll();
+    }
+    QCOMPARE(readData, alphabetArray);
+
+    QTRY_COMPARE(bytesWrittenSpy.size(), 1);
+    QCOMPARE(bytesWrittenSpy.at(0).at(0).toLongLong(), qint64(alphabetArray.size()));
+}
+
+void tst_QSerialPort::writeCoalescing()
+{
+    QSerialPort senderPort(m_senderPortName);
+    senderPort.setWriteCoalescing(1024, std::chrono::milliseconds(20));
+    QCOMPARE(senderPort.writeCoalescingMaxBytes(), qint64(1024));
+    QCOMPARE(senderPort.writeCoalescingMaxDelay(), std::chrono::milliseconds(20));
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    QSignalSpy bytesWrittenSpy(&senderPort, &QSerialPort::bytesWritten);
+    QVERIFY(bytesWrittenSpy.isValid());
+
+    for (const char c : alphabetArray)
+        QCOMPARE(senderPort.write(&c, 1), qint64(1));
+
+    QCoreApplication::processEvents();
+    QCOMPARE(senderPort.bytesToWrite(), qint64(alphabetArray.size()));
+
+    // The held back data is written at once after the delay
+    QTRY_COMPARE(bytesWrittenSpy.size(), 1);
+    QCOMPARE(bytesWrittenSpy.at(0).at(0).toLongLong(), qint64(alphabetArray.size()));
+
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(alphabetArray.size()));
+    QCOMPARE(receiverPort.readAll(), alphabetArray);
+}
+
+void tst_QSerialPort::waitForTransmitted()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(!senderPort.waitForTransmitted(100));
+    QCOMPARE(senderPort.error(), QSerialPort::NotOpenError);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    QSignalSpy transmittedSpy(&senderPort, &QSerialPort::allBytesTransmitted);
+    QVERIFY(transmittedSpy.isValid());
+
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY2(senderPort.waitForTransmitted(1000), "Waiting for bytes transmitted failed");
+    QCOMPARE(senderPort.bytesToWrite(), qint64(0));
+
+    QTRY_COMPARE(transmittedSpy.size(), 1);
+
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(alphabetArray.size()));
+    QCOMPARE(receiverPort.readAll(), alphabetArray);
+}
+
+void tst_QSerialPort::rs485Settings()
+{
+    QSerialPort serialPort(m_senderPortName);
+
+    const QSerialPort::Rs485Settings defaultSettings = serialPort.rs485Settings();
+    QVERIFY(!defaultSettings.isEnabled());
+    QVERIFY(defaultSettings.rtsOnSend());
+    QVERIFY(!defaultSettings.rtsAfterSend());
+    QVERIFY(!defaultSettings.receiveDuringTransmit());
+    QCOMPARE(defaultSettings.delayBeforeSend(), std::chrono::milliseconds(0));
+    QCOMPARE(defaultSettings.delayAfterSend(), std::chrono::milliseconds(0));
+
+    // The settings are applied in open()
+    QSerialPort::Rs485Settings settings;
+    settings.setEnabled(true);
+    settings.setRtsOnSend(false);
+    settings.setRtsAfterSend(true);
+    settings.setReceiveDuringTransmit(true);
+    settings.setDelayBeforeSend(std::chrono::milliseconds(1));
+    settings.setDelayAfterSend(std::chrono::milliseconds(2));
+    QVERIFY(serialPort.setRs485Settings(settings));
+
+    QSerialPort::Rs485Settings storedSettings = serialPort.rs485Settings();
+    QVERIFY(storedSettings.isEnabled());
+    QVERIFY(!storedSettings.rtsOnSend());
+    QVERIFY(storedSettings.rtsAfterSend());
+    QVERIFY(storedSettings.receiveDuringTransmit());
+    QCOMPARE(storedSettings.delayBeforeSend(), std::chrono::milliseconds(1));
+    QCOMPARE(storedSettings.delayAfterSend(), std::chrono::milliseconds(2));
+
+    // The copies are independent
+    storedSettings.setEnabled(false);
+    QVERIFY(settings.isEnabled());
+    QVERIFY(serialPort.rs485Settings().isEnabled());
+}
+
+void tst_QSerialPort::rs485SettingsDisabled()
+{
+    // Disabled settings do not make open() fail on ports without RS-485 support
+    QSerialPort serialPort(m_senderPortName);
+    QSerialPort::Rs485Settings settings;
+    settings.setEnabled(false);
+    settings.setDelayAfterSend(std::chrono::milliseconds(2));
+    QVERIFY(serialPort.setRs485Settings(settings));
+    QVERIFY(serialPort.open(QSerialPort::ReadWrite));
+    QCOMPARE(serialPort.error(), QSerialPort::NoError);
+    serialPort.close();
+
+    // Neither do the settings which disable the mode enabled before
+    settings.setEnabled(true);
+    QVERIFY(serialPort.setRs485Settings(settings));
+    settings.setEnabled(false);
+    QVERIFY(serialPort.setRs485Settings(settings));
+    QVERIFY(serialPort.open(QSerialPort::ReadWrite));
+    QCOMPARE(serialPort.error(), QSerialPort::NoError);
+}
+
+void tst_QSerialPort::rs485SettingsAfterOpen()
+{
+#ifndef Q_OS_LINUX
+    QSKIP("The RS-485 mode is only supported on Linux");
+#endif
+
+    QSerialPort serialPort(m_senderPortName);
+    QVERIFY(serialPort.open(QSerialPort::ReadWrite));
+
+    QSerialPort::Rs485Settings settings;
+    settings.setEnabled(true);
+    settings.setDelayBeforeSend(std::chrono::milliseconds(1));
+    if (!serialPort.setRs485Settings(settings))
+        QSKIP("The RS-485 mode is not supported by the serial port");
+
+    // the settings are read back from the driver
+    QVERIFY(serialPort.rs485Settings().isEnabled());
+
+    settings.setEnabled(false);
+    QVERIFY(serialPort.setRs485Settings(settings));
+    QVERIFY(!serialPort.rs485Settings().isEnabled());
+}
+
+void tst_QSerialPort::urgentPriorityWrite()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    const QByteArray bulkData(16384, 'x');
+    const QByteArray urgentData("!STOP!");
+
+    QCOMPARE(senderPort.write(bulkData), qint64(bulkData.size()));
+    QCOMPARE(senderPort.write(urgentData, QSerialPort::UrgentPriority), qint64(urgentData.size()));
+    QCOMPARE(senderPort.bytesToWrite(), qint64(bulkData.size() + urgentData.size()));
+
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(bulkData.size() + urgentData.size()));
+    QCOMPARE(receiverPort.readAll(), urgentData + bulkData);
+}
+
+void tst_QSerialPort::writePacing()
+{
+#ifdef Q_OS_WIN
+    QSKIP("The write pacing is not supported on Windows.");
+#endif
+
+    QSerialPort senderPort(m_senderPortName);
+    senderPort.setWriteRateLimit(1000, 10);
+    QCOMPARE(senderPort.writeRateLimit(), qint64(1000));
+    QCOMPARE(senderPort.writeBurstSize(), qint64(10));
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    // The first burst goes out at once, the rest at one byte per millisecond
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(alphabetArray.size()));
+    QVERIFY(elapsedTimer.elapsed() >= 15);
+    QCOMPARE(receiverPort.readAll(), alphabetArray);
+
+    senderPort.setWriteRateLimit(0);
+    senderPort.setWriteInterFrameGap(std::chrono::milliseconds(50));
+    QCOMPARE(senderPort.writeInterFrameGap(), std::chrono::microseconds(50000));
+
+    elapsedTimer.start();
+    QCOMPARE(senderPort.write(newlineArray), qint64(newlineArray.size()));
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(newlineArray.size() + alphabetArray.size()));
+    QVERIFY(elapsedTimer.elapsed() >= 50);
+    QCOMPARE(receiverPort.readAll(), newlineArray + alphabetArray);
+
+    // the blocking call waits for the paced data instead of returning early
+    senderPort.setWriteInterFrameGap(std::chrono::microseconds::zero());
+    senderPort.setWriteRateLimit(1000, 10);
+    QSignalSpy bytesWrittenSpy(&senderPort, &QSerialPort::bytesWritten);
+    QVERIFY(bytesWrittenSpy.isValid());
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    while (senderPort.bytesToWrite() > 0) {
+        const qsizetype emittedCount = bytesWrittenSpy.size();
+        QVERIFY2(senderPort.waitForBytesWritten(500), "Waiting for bytes written failed");
+        QCOMPARE(bytesWrittenSpy.size(), emittedCount + 1);
+    }
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(alphabetArray.size()));
+    QCOMPARE(receiverPort.readAll(), alphabetArray);
+
+    // the data queued before the gap is enabled is a frame of its own
+    senderPort.setWriteRateLimit(0);
+    QCOMPARE(senderPort.write(newlineArray), qint64(newlineArray.size()));
+    senderPort.setWriteInterFrameGap(std::chrono::milliseconds(50));
+    elapsedTimer.start();
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(newlineArray.size() + alphabetArray.size()));
+    QVERIFY(elapsedTimer.elapsed() >= 50);
+    QCOMPARE(receiverPort.readAll(), newlineArray + alphabetArray);
+}
+
+void tst_QSerialPort::bytesInDriver()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QCOMPARE(senderPort.bytesInDriverTx(), qint64(-1));
+    QCOMPARE(senderPort.bytesInDriverRx(), qint64(-1));
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+    QCOMPARE(receiverPort.bytesInDriverRx(), qint64(0));
+
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY2(senderPort.waitForTransmitted(1000), "Waiting for bytes transmitted failed");
+    QCOMPARE(senderPort.bytesInDriverTx(), qint64(0));
+
+    // Whatever has not been read into the buffer yet is still in the driver
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(alphabetArray.size()));
+    QCOMPARE(receiverPort.bytesInDriverRx(), qint64(0));
+    QCOMPARE(receiverPort.readAll(), alphabetArray);
+
+#ifndef Q_OS_WIN
+    // In the unbuffered mode, bytesAvailable() counts the data in the driver
+    receiverPort.close();
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly | QSerialPort::Unbuffered));
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY2(senderPort.waitForTransmitted(1000), "Waiting for bytes transmitted failed");
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(alphabetArray.size()));
+    QCOMPARE(receiverPort.bytesInDriverRx(), qint64(0));
+    QCOMPARE(receiverPort.readAll(), alphabetArray);
+#endif
+}
+
+void tst_QSerialPort::waitForBytesAvailableAndDelimiter()
+{
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(!receiverPort.waitForBytesAvailable(1, 100));
+    QCOMPARE(receiverPort.error(), QSerialPort::NotOpenError);
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    QVERIFY(!receiverPort.waitForBytesAvailable(1, 100));
+    QCOMPARE(receiverPort.error(), QSerialPort::TimeoutError);
+    receiverPort.clearError();
+
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY2(senderPort.waitForBytesWritten(1000), "Waiting for bytes written failed");
+    QVERIFY2(receiverPort.waitForBytesAvailable(alphabetArray.size(), 1000),
+             "Waiting for bytes available failed");
+    QCOMPARE(receiverPort.readAll(), alphabetArray);
+
+    const QByteArray frame = alphabetArray + newlineArray;
+    QCOMPARE(senderPort.write(frame), qint64(frame.size()));
+    QVERIFY2(senderPort.waitForBytesWritten(1000), "Waiting for bytes written failed");
+    QVERIFY2(receiverPort.waitForDelimiter(newlineArray, 1000), "Waiting for delimiter failed");
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(frame.size()));
+    QCOMPARE(receiverPort.readAll(), frame);
+
+    QVERIFY(!receiverPort.waitForDelimiter(newlineArray, 100));
+    QCOMPARE(receiverPort.error(), QSerialPort::TimeoutError);
+    receiverPort.clearError();
+
+    // the buffer could never hold the requested amount
+    receiverPort.setReadBufferSize(8);
+    QVERIFY(!receiverPort.waitForBytesAvailable(16, 1000));
+    QCOMPARE(receiverPort.error(), QSerialPort::UnsupportedOperationError);
+}
+
+void tst_QSerialPort::waitForAnyReadyRead()
+{
+#ifdef Q_OS_WIN
+    QSKIP("Waiting on several ports is not supported on Windows.");
+#endif
+
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    const QList<QSerialPort *> ports = { &senderPort, &receiverPort };
+    QVERIFY(QSerialPort::waitForAnyReadyRead(ports, 100).isEmpty());
+    QCOMPARE(receiverPort.error(), QSerialPort::TimeoutError);
+    receiverPort.clearError();
+
+    // The pending write of the sender is continued while waiting
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QByteArray readData;
+    while (readData.size() < alphabetArray.size()) {
+        const QList<QSerialPort *> readyPorts = QSerialPort::waitForAnyReadyRead(ports, 1000);
+        QCOMPARE(readyPorts, QList<QSerialPort *>{ &receiverPort });
+        readData.append(receiverPort.readAll());
+    }
+    QCOMPARE(readData, alphabetArray);
+    QCOMPARE(senderPort.bytesToWrite(), qint64(0));
+}
+
+void tst_QSerialPort::busyPoll()
+{
+    QSerialPort receiverPort(m_receiverPortName);
+    QCOMPARE(receiverPort.busyPollDuration(), std::chrono::microseconds(0));
+    QCOMPARE(receiverPort.busyPollHitCount(), qint64(0));
+    QCOMPARE(receiverPort.busyPollFallbackCount(), qint64(0));
+
+#ifdef Q_OS_WIN
+    QSKIP("Busy polling is not supported on Windows.");
+#endif
+
+    receiverPort.setBusyPollDuration(std::chrono::milliseconds(500));
+    QCOMPARE(receiverPort.busyPollDuration(), std::chrono::microseconds(500000));
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    QVERIFY(!receiverPort.waitForReadyRead(100));
+    QCOMPARE(receiverPort.busyPollHitCount(), qint64(0));
+    QCOMPARE(receiverPort.busyPollFallbackCount(), qint64(1));
+
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY2(senderPort.waitForBytesWritten(1000), "Waiting for bytes written failed");
+
+    QVERIFY2(receiverPort.waitForReadyRead(1000), "Waiting for ready read failed");
+    QCOMPARE(receiverPort.busyPollHitCount(), qint64(1));
+    QCOMPARE(receiverPort.busyPollFallbackCount(), qint64(1));
+}
+
+void tst_QSerialPort::interruptWait()
+{
+#ifdef Q_OS_WIN
+    QSKIP("Interrupting a wait is not supported on Windows.");
+#endif
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    // A pending interruption ends the next wait at once
+    QElapsedTimer stopWatch;
+    stopWatch.start();
+    receiverPort.interruptWait();
+    QVERIFY(!receiverPort.waitForReadyRead(10000));
+    QCOMPARE(receiverPort.error(), QSerialPort::TimeoutError);
+    QVERIFY(stopWatch.elapsed() < 5000);
+    receiverPort.clearError();
+
+    std::unique_ptr<QThread> interruptingThread(QThread::create([&receiverPort] {
+        QThread::msleep(100);
+        receiverPort.interruptWait();
+    }));
+    stopWatch.restart();
+    interruptingThread->start();
+    QVERIFY(!receiverPort.waitForReadyRead(-1));
+    QCOMPARE(receiverPort.error(), QSerialPort::TimeoutError);
+    QVERIFY(stopWatch.elapsed() < 5000);
+    QVERIFY(interruptingThread->wait(1000));
+
+    // The interruption has been consumed
+    receiverPort.clearError();
+    QVERIFY(!receiverPort.waitForReadyRead(100));
+    QCOMPARE(receiverPort.error(), QSerialPort::TimeoutError);
+
+    // The busy polling stops spinning when interrupted
+    receiverPort.clearError();
+    receiverPort.setBusyPollDuration(std::chrono::seconds(10));
+    stopWatch.restart();
+    receiverPort.interruptWait();
+    QVERIFY(!receiverPort.waitForReadyRead(-1));
+    QCOMPARE(receiverPort.error(), QSerialPort::TimeoutError);
+    QVERIFY(stopWatch.elapsed() < 5000);
+    receiverPort.setBusyPollDuration(std::chrono::microseconds::zero());
+
+    // So does the wait on several ports
+    receiverPort.clearError();
+    interruptingThread.reset(QThread::create([&receiverPort] {
+        QThread::msleep(100);
+        receiverPort.interruptWait();
+    }));
+    stopWatch.restart();
+    interruptingThread->start();
+    QVERIFY(QSerialPort::waitForAnyReadyRead({ &receiverPort }, -1).isEmpty());
+    QCOMPARE(receiverPort.error(), QSerialPort::TimeoutError);
+    QVERIFY(stopWatch.elapsed() < 5000);
+    QVERIFY(interruptingThread->wait(1000));
+}
+
+void tst_QSerialPort::ioThread()
+{
+#ifdef Q_OS_WIN
+    QSKIP("The I/O thread is not supported on Windows.");
+#endif
+
+    QSerialPort receiverPort(m_receiverPortName);
+    QVERIFY(!receiverPort.isIoThreadEnabled());
+    receiverPort.setIoThreadEnabled(true);
+    QVERIFY(receiverPort.isIoThreadEnabled());
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+
+    // The data is received while the owner thread is blocked
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QVERIFY2(senderPort.waitForBytesWritten(1000), "Waiting for bytes written failed");
+    QThread::msleep(100);
+
+    QSignalSpy readyReadSpy(&receiverPort, &QSerialPort::readyRead);
+    QVERIFY(readyReadSpy.isValid());
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(alphabetArray.size()));
+    QVERIFY(readyReadSpy.size() > 0);
+    QCOMPARE(receiverPort.readAll(), alphabetArray);
+
+    // The blocking API waits for the data of the I/O thread
+    QCOMPARE(senderPort.write(newlineArray), qint64(newlineArray.size()));
+    QVERIFY2(senderPort.waitForBytesWritten(1000), "Waiting for bytes written failed");
+    QVERIFY2(receiverPort.waitForBytesAvailable(newlineArray.size(), 1000),
+             "Waiting for bytes available failed");
+    QCOMPARE(receiverPort.readAll(), newlineArray);
+
+    receiverPort.close();
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+    QVERIFY(!receiverPort.waitForReadyRead(100));
+    QCOMPARE(receiverPort.error(), QSerialPort::TimeoutError);
+}
+
+void tst_QSerialPort::sharedReactor()
+{
+#ifndef Q_OS_LINUX
+    QSKIP("The shared reactor is only supported on Linux.");
+#endif
+
+    QSerialPort senderPort(m_senderPortName);
+    QVERIFY(!senderPort.isSharedReactorEnabled());
+    senderPort.setSharedReactorEnabled(true);
+    QVERIFY(senderPort.isSharedReactorEnabled());
+    QVERIFY(senderPort.open(QSerialPort::ReadWrite));
+
+    QSerialPort receiverPort(m_receiverPortName);
+    receiverPort.setSharedReactorEnabled(true);
+    QVERIFY(receiverPort.open(QSerialPort::ReadWrite));
+
+    QSignalSpy bytesWrittenSpy(&senderPort, &QSerialPort::bytesWritten);
+    QVERIFY(bytesWrittenSpy.isValid());
+    QSignalSpy senderReadyReadSpy(&senderPort, &QSerialPort::readyRead);
+    QVERIFY(senderReadyReadSpy.isValid());
+    QSignalSpy receiverReadyReadSpy(&receiverPort, &QSerialPort::readyRead);
+    QVERIFY(receiverReadyReadSpy.isValid());
+
+    // Both ports are serviced by the reactor of this thread at the same
+    // time, without any notifiers of their own.
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QCOMPARE(receiverPort.write(newlineArray), qint64(newlineArray.size()));
+    QVERIFY(senderPort.findChildren<QSocketNotifier *>().isEmpty());
+    QVERIFY(receiverPort.findChildren<QSocketNotifier *>().isEmpty());
+
+    QTRY_VERIFY(bytesWrittenSpy.size() > 0);
+    QTRY_COMPARE(senderPort.bytesToWrite(), qint64(0));
+    QTRY_COMPARE(receiverPort.bytesToWrite(), qint64(0));
+
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(alphabetArray.size()));
+    QTRY_COMPARE(senderPort.bytesAvailable(), qint64(newlineArray.size()));
+    QVERIFY(receiverReadyReadSpy.size() > 0);
+    QVERIFY(senderReadyReadSpy.size() > 0);
+    QCOMPARE(receiverPort.readAll(), alphabetArray);
+    QCOMPARE(senderPort.readAll(), newlineArray);
+    QVERIFY(senderPort.findChildren<QSocketNotifier *>().isEmpty());
+    QVERIFY(receiverPort.findChildren<QSocketNotifier *>().isEmpty());
+
+    // Closing one of the ports keeps the other one serviced
+    senderPort.close();
+    QVERIFY(senderPort.open(QSerialPort::WriteOnly));
+    QCOMPARE(senderPort.write(newlineArray), qint64(newlineArray.size()));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(newlineArray.size()));
+    QCOMPARE(receiverPort.readAll(), newlineArray);
+    QVERIFY(receiverPort.findChildren<QSocketNotifier *>().isEmpty());
+
+    // Without the reactor, the port uses its own notifiers
+    receiverPort.close();
+    receiverPort.setSharedReactorEnabled(false);
+    QVERIFY(receiverPort.open(QSerialPort::ReadOnly));
+    QCOMPARE(senderPort.write(alphabetArray), qint64(alphabetArray.size()));
+    QTRY_COMPARE(receiverPort.bytesAvailable(), qint64(alphabetArray.size()));
+    QVERIFY(!receiverPort.findChildren<QSocketNotifier *>().isEmpty());
+    QCOMPARE(receiverPort.readAll(), alphabetArray);
+}
+
 class SenderTransactor : public QObject
 {
     Q_OBJECT
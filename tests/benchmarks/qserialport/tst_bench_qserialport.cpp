@@ -0,0 +1,125 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+#include <QtSerialPort/QSerialPort>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <memory>
+#include <vector>
+
+// Compares the readyRead() dispatch of many ports with a pair of notifiers
+// per port, and with the shared reactor, using pseudo-terminals as ports.
+class tst_QSerialPortBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void readyReadDispatch_data();
+    void readyReadDispatch();
+};
+
+struct PseudoTerminal
+{
+    PseudoTerminal() = default;
+    PseudoTerminal(const PseudoTerminal &) = delete;
+    PseudoTerminal &operator=(const PseudoTerminal &) = delete;
+    ~PseudoTerminal()
+    {
+        if (master != -1)
+            ::close(master);
+    }
+
+    bool open()
+    {
+        master = ::posix_openpt(O_RDWR | O_NOCTTY);
+        if (master == -1 || ::grantpt(master) == -1 || ::unlockpt(master) == -1)
+            return false;
+        const char *name = ::ptsname(master);
+        if (!name)
+            return false;
+        slaveName = QString::fromLocal8Bit(name);
+        return true;
+    }
+
+    int master = -1;
+    QString slaveName;
+};
+
+void tst_QSerialPortBenchmark::initTestCase()
+{
+    // Every port takes a master and a slave descriptor, and a few more
+    // for the wakeups, so raise the limit as far as allowed.
+    rlimit limit;
+    if (::getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        ::setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+void tst_QSerialPortBenchmark::readyReadDispatch_data()
+{
+    QTest::addColumn<int>("portCount");
+    QTest::addColumn<bool>("sharedReactor");
+
+    for (int portCount : { 16, 128, 512 }) {
+        QTest::addRow("notifiers, %d ports", portCount) << portCount << false;
+        QTest::addRow("shared reactor, %d ports", portCount) << portCount << true;
+    }
+}
+
+void tst_QSerialPortBenchmark::readyReadDispatch()
+{
+    QFETCH(int, portCount);
+    QFETCH(bool, sharedReactor);
+
+    std::vector<std::unique_ptr<PseudoTerminal>> terminals;
+    std::vector<std::unique_ptr<QSerialPort>> ports;
+    qint64 receivedBytes = 0;
+
+    for (int i = 0; i < portCount; ++i) {
+        auto terminal = std::make_unique<PseudoTerminal>();
+        if (!terminal->open())
+            QSKIP("Not enough pseudo-terminals available");
+
+        auto port = std::make_unique<QSerialPort>(terminal->slaveName);
+        port->setSharedReactorEnabled(sharedReactor);
+        if (!port->open(QIODevice::ReadOnly))
+            QSKIP(qPrintable(QStringLiteral("Cannot open %1: %2")
+                             .arg(terminal->slaveName, port->errorString())));
+
+        QSerialPort *serialPort = port.get();
+        connect(serialPort, &QSerialPort::readyRead, serialPort, [serialPort, &receivedBytes] {
+            receivedBytes += serialPort->readAll().size();
+        });
+
+        terminals.push_back(std::move(terminal));
+        ports.push_back(std::move(port));
+    }
+
+    const char byte = 'x';
+    QBENCHMARK {
+        receivedBytes = 0;
+        for (const auto &terminal : terminals)
+            QCOMPARE(::write(terminal->master, &byte, 1), ssize_t(1));
+
+        QTimer timeoutTimer;
+        timeoutTimer.setSingleShot(true);
+        timeoutTimer.start(5000);
+        while (receivedBytes < portCount && timeoutTimer.isActive())
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+        QCOMPARE(receivedBytes, qint64(portCount));
+    }
+
+    // The ports go before the terminals they use
+    ports.clear();
+}
+
+QTEST_GUILESS_MAIN(tst_QSerialPortBenchmark)
+#include "tst_bench_qserialport.moc"